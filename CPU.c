@@ -1,46 +1,36 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include "CPU.h"
+#include "trace_format.h"
+#include "energy_model.h"
+#include "policy_engine.h"
 
-#define MAX_PROCESSES 20
-
-typedef struct {
-    char name[10];
-    int arrival_time;
-    int burst_time;
-    int priority;
-    int start_time;
-    int completion_time;
-    int turnaround_time;
-    int waiting_time;
-    int remaining_time;
-} Process;
-
-typedef struct {
-    Process processes[MAX_PROCESSES];
-    int count;
-} ProcessList;
-
-void load_dataset(ProcessList *pl, const char *filename);
-void print_results(ProcessList *pl);
-void calculate_metrics(ProcessList *pl);
-void fcfs(ProcessList *pl);
-void sjf(ProcessList *pl);
-void srtf(ProcessList *pl);
-void round_robin(ProcessList *pl, int quantum);
-void priority_preemptive(ProcessList *pl);
-void priority_non_preemptive(ProcessList *pl);
-void print_gantt_chart(ProcessList *pl);
-void sort_by_arrival(ProcessList *pl);
-void sort_by_burst(ProcessList *pl);
-void sort_by_priority(ProcessList *pl);
-
-int main() {
+#ifndef SCHEDULER_NO_MAIN
+int main(int argc, char *argv[]) {
     ProcessList pl = {0};
     int choice, quantum;
     char filename[100];
+
+    if (argc == 4 && strcmp(argv[1], "convert") == 0) {
+        return convert_dataset(argv[2], argv[3]) ? 0 : 1;
+    }
+    if (argc >= 3 && strcmp(argv[1], "sweep") == 0) {
+        int q_min = argc > 3 ? atoi(argv[3]) : 1;
+        int q_max = argc > 4 ? atoi(argv[4]) : 10;
+        int q_step = argc > 5 ? atoi(argv[5]) : 1;
+        int threads = argc > 6 ? atoi(argv[6]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        return run_sweep(argv[2], q_min, q_max, q_step, threads) ? 0 : 1;
+    }
     
     printf("Energy-Sufficient CPU Scheduling Simulator\n");
     printf("=========================================\n\n");
@@ -56,6 +46,7 @@ int main() {
     printf("4. Round Robin (RR)\n");
     printf("5. Priority with Preemption\n");
     printf("6. Priority without Preemption\n");
+    printf("7. Energy-aware Multi-Level Feedback Queue (MLFQ)\n");
     printf("Enter your choice: ");
     scanf("%d", &choice);
     
@@ -80,6 +71,11 @@ int main() {
         case 6:
             priority_non_preemptive(&pl);
             break;
+        case 7:
+            printf("Enter base time quantum: ");
+            scanf("%d", &quantum);
+            mlfq(&pl, quantum);
+            break;
         default:
             printf("Invalid choice\n");
             return 1;
@@ -91,26 +87,290 @@ int main() {
     printf("\nGantt Chart:\n");
     print_gantt_chart(&pl);
     
+    free_process_list(&pl);
     return 0;
 }
+#endif
 
 void load_dataset(ProcessList *pl, const char *filename) {
-    FILE *file = fopen(filename, "r");
+    DatasetReader reader;
+    if (trace_is_binary(filename)) {
+        load_binary_dataset(pl, filename);
+        return;
+    }
+    if (!open_dataset(&reader, filename)) {
+        printf("Error opening file\n");
+        exit(1);
+    }
+
+    while (read_dataset_chunk(&reader, pl, DATASET_CHUNK_ROWS) > 0) {
+    }
+
+    if (reader.errors > 0) {
+        fprintf(stderr, "%s: skipped %d malformed line(s)\n", filename, reader.errors);
+    }
+    close_dataset(&reader);
+}
+
+/* Binary workloads are mapped and copied column by column into the
+   process list; nothing is parsed. */
+void load_binary_dataset(ProcessList *pl, const char *filename) {
+    TraceFile tf;
+    if (!trace_open(&tf, filename, TRACE_WORKLOAD)) {
+        exit(1);
+    }
+    if (tf.header->row_count > (uint64_t)(INT_MAX - pl->count)) {
+        printf("Error: %s has too many rows\n", filename);
+        exit(1);
+    }
+
+    int rows = (int)tf.header->row_count;
+    const int32_t *arrival = trace_column(&tf, WORKLOAD_ARRIVAL);
+    const int32_t *burst = trace_column(&tf, WORKLOAD_BURST);
+    const int32_t *priority = trace_column(&tf, WORKLOAD_PRIORITY);
+    const char (*names)[TRACE_NAME_WIDTH] = trace_column(&tf, WORKLOAD_NAME);
+
+    reserve_processes(pl, pl->count + rows);
+    for (int i = 0; i < rows; i++) {
+        Process *p = append_process(pl);
+        memcpy(p->name, names[i], sizeof(p->name) - 1);
+        p->arrival_time = arrival[i];
+        p->burst_time = burst[i];
+        p->priority = priority[i];
+        p->remaining_time = p->burst_time;
+    }
+    trace_close(&tf);
+}
+
+int save_text_dataset(ProcessList *pl, const char *filename) {
+    FILE *file = fopen(filename, "w");
     if (!file) {
         printf("Error opening file\n");
+        return 0;
+    }
+    fprintf(file, "Name Arrival Burst Priority\n");
+    for (int i = 0; i < pl->count; i++) {
+        Process *p = &pl->processes[i];
+        fprintf(file, "%s %d %d %d\n", p->name, p->arrival_time, p->burst_time, p->priority);
+    }
+    return fclose(file) == 0;
+}
+
+int save_binary_dataset(ProcessList *pl, const char *filename) {
+    int n = pl->count;
+    int32_t *columns = malloc(3 * (size_t)(n > 0 ? n : 1) * sizeof(int32_t));
+    char (*names)[TRACE_NAME_WIDTH] = calloc(n > 0 ? n : 1, TRACE_NAME_WIDTH);
+    if (!columns || !names) {
+        printf("Error allocating trace columns\n");
         exit(1);
     }
-    
-    char line[100];
-    fgets(line, sizeof(line), file); 
-    
-    while (fgets(line, sizeof(line), file) && pl->count < MAX_PROCESSES) {
-        Process *p = &pl->processes[pl->count++];
-        sscanf(line, "%s %d %d %d", p->name, &p->arrival_time, &p->burst_time, &p->priority);
+
+    int32_t *arrival = columns, *burst = columns + n, *priority = columns + 2 * n;
+    for (int i = 0; i < n; i++) {
+        Process *p = &pl->processes[i];
+        arrival[i] = p->arrival_time;
+        burst[i] = p->burst_time;
+        priority[i] = p->priority;
+        memcpy(names[i], p->name, strnlen(p->name, sizeof(p->name)));
+    }
+
+    int ok = trace_write_workload(filename, n, arrival, burst, priority,
+                                  (const char (*)[TRACE_NAME_WIDTH])names);
+    free(columns);
+    free(names);
+    return ok;
+}
+
+/* Text datasets become binary workloads and binary workloads become text,
+   so the same command converts in either direction. */
+int convert_dataset(const char *input, const char *output) {
+    ProcessList pl = {0};
+    bool to_text = trace_is_binary(input);
+
+    load_dataset(&pl, input);
+    int ok = to_text ? save_text_dataset(&pl, output) : save_binary_dataset(&pl, output);
+    if (ok) {
+        printf("Converted %d processes from %s to %s (%s)\n",
+               pl.count, input, output, to_text ? "text" : "binary");
+    }
+    free_process_list(&pl);
+    return ok;
+}
+
+/* Maps the whole dataset read-only and lets the kernel page it in
+   sequentially. Files that cannot be mapped (pipes, empty files) are
+   read into memory instead. The header line is skipped here. */
+int open_dataset(DatasetReader *r, const char *filename) {
+    memset(r, 0, sizeof(DatasetReader));
+    r->filename = filename;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            r->data = data;
+            r->size = st.st_size;
+            r->mapped = true;
+        }
+    }
+
+    if (!r->mapped) {
+        size_t capacity = 1 << 16;
+        r->data = malloc(capacity);
+        ssize_t n;
+        while (r->data && (n = read(fd, r->data + r->size, capacity - r->size)) > 0) {
+            r->size += n;
+            if (r->size == capacity) {
+                capacity *= 2;
+                char *grown = realloc(r->data, capacity);
+                if (!grown) {
+                    free(r->data);
+                    r->data = NULL;
+                    break;
+                }
+                r->data = grown;
+            }
+        }
+        if (!r->data) {
+            close(fd);
+            return 0;
+        }
+    }
+    close(fd);
+
+    const char *newline = memchr(r->data, '\n', r->size);
+    r->pos = newline ? (size_t)(newline - r->data) + 1 : r->size;
+    r->line = 1;
+    return 1;
+}
+
+/* Parses up to max_rows rows onto the end of pl and returns how many
+   were added, 0 once the file is exhausted. Callers can start working
+   on the rows already appended before the rest has been parsed. */
+int read_dataset_chunk(DatasetReader *r, ProcessList *pl, int max_rows) {
+    int added = 0;
+
+    while (added < max_rows && r->pos < r->size) {
+        const char *cur = r->data + r->pos;
+        const char *end = r->data + r->size;
+        const char *newline = memchr(cur, '\n', end - cur);
+        const char *eol = newline ? newline : end;
+
+        r->pos = (eol - r->data) + (newline ? 1 : 0);
+        r->line++;
+
+        if (eol > cur && eol[-1] == '\r') eol--;
+
+        const char *s = cur;
+        while (s < eol && (*s == ' ' || *s == '\t')) s++;
+        if (s == eol) continue;
+
+        const char *name = s;
+        while (s < eol && *s != ' ' && *s != '\t') s++;
+        size_t name_len = s - name;
+
+        int fields[3];
+        bool ok = true;
+        for (int f = 0; f < 3 && ok; f++) {
+            ok = parse_int_field(&s, eol, &fields[f]);
+        }
+        while (ok && s < eol && (*s == ' ' || *s == '\t')) s++;
+
+        if (!ok || s != eol) {
+            fprintf(stderr, "%s:%d: malformed line, expected \"name arrival burst priority\"\n",
+                    r->filename, r->line);
+            r->errors++;
+            continue;
+        }
+
+        Process *p = append_process(pl);
+        if (name_len >= sizeof(p->name)) name_len = sizeof(p->name) - 1;
+        memcpy(p->name, name, name_len);
+        p->name[name_len] = '\0';
+        p->arrival_time = fields[0];
+        p->burst_time = fields[1];
+        p->priority = fields[2];
         p->remaining_time = p->burst_time;
+        added++;
     }
-    
-    fclose(file);
+
+    return added;
+}
+
+void close_dataset(DatasetReader *r) {
+    if (r->mapped) {
+        munmap(r->data, r->size);
+    } else {
+        free(r->data);
+    }
+    r->data = NULL;
+    r->size = r->pos = 0;
+}
+
+/* Skips leading blanks and reads one signed decimal int, rejecting
+   anything that is not followed by a blank or the end of the line. */
+bool parse_int_field(const char **cursor, const char *end, int *out) {
+    const char *s = *cursor;
+    while (s < end && (*s == ' ' || *s == '\t')) s++;
+
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = (*s == '-');
+        s++;
+    }
+    if (s == end || *s < '0' || *s > '9') return false;
+
+    long long value = 0;
+    while (s < end && *s >= '0' && *s <= '9') {
+        value = value * 10 + (*s - '0');
+        if (value > (long long)INT_MAX + 1) return false;
+        s++;
+    }
+    if (s < end && *s != ' ' && *s != '\t') return false;
+    if (negative) value = -value;
+    if (value > INT_MAX || value < INT_MIN) return false;
+
+    *out = (int)value;
+    *cursor = s;
+    return true;
+}
+
+Process *append_process(ProcessList *pl) {
+    if (pl->count == pl->capacity) {
+        int capacity = pl->capacity ? pl->capacity * 2 : 64;
+        Process *grown = realloc(pl->processes, capacity * sizeof(Process));
+        if (!grown) {
+            printf("Error allocating process list\n");
+            exit(1);
+        }
+        pl->processes = grown;
+        pl->capacity = capacity;
+    }
+    Process *p = &pl->processes[pl->count++];
+    memset(p, 0, sizeof(Process));
+    return p;
+}
+
+void reserve_processes(ProcessList *pl, int capacity) {
+    if (capacity <= pl->capacity) return;
+    Process *grown = realloc(pl->processes, capacity * sizeof(Process));
+    if (!grown) {
+        printf("Error allocating process list\n");
+        exit(1);
+    }
+    pl->processes = grown;
+    pl->capacity = capacity;
+}
+
+void free_process_list(ProcessList *pl) {
+    timeline_free(&pl->timeline);
+    free(pl->processes);
+    pl->processes = NULL;
+    pl->count = pl->capacity = 0;
 }
 
 void print_results(ProcessList *pl) {
@@ -126,7 +386,7 @@ void print_results(ProcessList *pl) {
 }
 
 void calculate_metrics(ProcessList *pl) {
-    int total_tat = 0, total_wt = 0;
+    long long total_tat = 0, total_wt = 0;
     
     for (int i = 0; i < pl->count; i++) {
         Process *p = &pl->processes[i];
@@ -135,361 +395,432 @@ void calculate_metrics(ProcessList *pl) {
     }
     
     printf("\nPerformance Metrics:\n");
-    printf("Total Turnaround Time: %d\n", total_tat);
-    printf("Average Turnaround Time: %.2f\n", (float)total_tat / pl->count);
-    printf("Total Waiting Time: %d\n", total_wt);
-    printf("Average Waiting Time: %.2f\n", (float)total_wt / pl->count);
+    printf("Total Turnaround Time: %lld\n", total_tat);
+    printf("Average Turnaround Time: %.2f\n", (double)total_tat / pl->count);
+    printf("Total Waiting Time: %lld\n", total_wt);
+    printf("Average Waiting Time: %.2f\n", (double)total_wt / pl->count);
+
+    EnergyReport energy = timeline_energy(pl);
+    printf("Energy: %lld mJ (%d context switches, %d idle periods)\n",
+           energy.energy, energy.context_switches, energy.idle_periods);
 }
 
-void print_gantt_chart(ProcessList *pl) {
-  
-    int max_time = 0;
-    for (int i = 0; i < pl->count; i++) {
-        if (pl->processes[i].completion_time > max_time) {
-            max_time = pl->processes[i].completion_time;
+/* Charges a finished schedule's timeline through the shared energy
+   model: active time (half rate for processes with a burst under 2 ms,
+   as in energy_scheduler.c), one transition penalty per context
+   switch, and for each idle gap a penalty to sleep, idle power, and a
+   penalty to wake. The CPU starts asleep, so the first run pays a
+   wake-up. */
+EnergyReport timeline_energy(const ProcessList *pl) {
+    EnergyReport report = {0, 0, 0};
+    const Timeline *tl = &pl->timeline;
+    int prev_end = 0;
+    for (int i = 0; i < tl->count; i++) {
+        const Segment *seg = &tl->segments[i];
+        int len = seg->end - seg->start;
+        if (i == 0) {
+            report.energy += (long long)seg->start * ENERGY_IDLE + STATE_TRANSITION_PENALTY;
+        } else if (seg->start > prev_end) {
+            report.energy += 2 * STATE_TRANSITION_PENALTY +
+                             (long long)(seg->start - prev_end) * ENERGY_IDLE;
+            report.idle_periods++;
+        } else {
+            report.energy += STATE_TRANSITION_PENALTY;
+            report.context_switches++;
         }
+        int burst = pl->processes[seg->process].burst_time;
+        report.energy += (long long)len * (burst < 2 ? ENERGY_ACTIVE_BASE / 2 : ENERGY_ACTIVE_BASE);
+        prev_end = seg->end;
     }
-    
-    
+    return report;
+}
+
+/* Renders the recorded run segments. Each column is two characters
+   wide and covers a fixed bucket of time, sized so the chart fits in
+   GANTT_COLUMNS columns; a column shows whichever process ran longest
+   within its bucket, or blanks if the CPU was idle throughout. */
+void print_gantt_chart(ProcessList *pl) {
+    Timeline *tl = &pl->timeline;
+    int max_time = tl->count > 0 ? tl->segments[tl->count - 1].end : 0;
+    int bucket = (max_time + GANTT_COLUMNS - 1) / GANTT_COLUMNS;
+    if (bucket < 1) bucket = 1;
+    int columns = (max_time + bucket - 1) / bucket;
+
+    if (bucket > 1) {
+        printf("(1 column = %d time units, %d segments)\n", bucket, tl->count);
+    }
+
     printf("+");
-    for (int i = 0; i <= max_time; i++) {
+    for (int c = 0; c < columns; c++) {
         printf("--");
     }
     printf("+\n");
-    
 
     printf("|");
-    for (int i = 0; i < pl->count; i++) {
-        Process *p = &pl->processes[i];
-        int duration = p->completion_time - p->start_time;
-        for (int j = 0; j < duration; j++) {
-            printf("%.2s", p->name);
+    int s = 0;
+    for (int c = 0; c < columns; c++) {
+        int lo = c * bucket, hi = lo + bucket;
+        int best = -1, best_overlap = 0;
+        while (s < tl->count && tl->segments[s].end <= lo) s++;
+        for (int k = s; k < tl->count && tl->segments[k].start < hi; k++) {
+            Segment *seg = &tl->segments[k];
+            int overlap = (seg->end < hi ? seg->end : hi) - (seg->start > lo ? seg->start : lo);
+            if (overlap > best_overlap) {
+                best_overlap = overlap;
+                best = seg->process;
+            }
+        }
+        if (best >= 0) {
+            printf("%-2.2s", pl->processes[best].name);
+        } else {
+            printf("  ");
         }
     }
     printf("|\n");
-    
-   
+
     printf("+");
-    for (int i = 0; i <= max_time; i++) {
+    for (int c = 0; c < columns; c++) {
         printf("--");
     }
     printf("+\n");
-    
-    printf("0");
-    for (int i = 1; i <= max_time; i++) {
-        printf(" %2d", i);
+
+    int printed = 0;
+    for (int c = 0; c <= columns; c += 5) {
+        int label = c * bucket;
+        printed += printf("%*s%d", 2 * c - printed > 0 ? 2 * c - printed : 0, "", label);
     }
     printf("\n");
 }
 
-void sort_by_arrival(ProcessList *pl) {
-    for (int i = 0; i < pl->count - 1; i++) {
-        for (int j = 0; j < pl->count - i - 1; j++) {
-            if (pl->processes[j].arrival_time > pl->processes[j+1].arrival_time) {
-                Process temp = pl->processes[j];
-                pl->processes[j] = pl->processes[j+1];
-                pl->processes[j+1] = temp;
-            }
+void timeline_clear(Timeline *tl) {
+    tl->count = 0;
+}
+
+void timeline_append(Timeline *tl, int process, int start, int end) {
+    if (end <= start) return;
+    if (tl->count > 0) {
+        Segment *last = &tl->segments[tl->count - 1];
+        if (last->process == process && last->end == start) {
+            last->end = end;
+            return;
+        }
+    }
+    if (tl->count == tl->capacity) {
+        int capacity = tl->capacity ? tl->capacity * 2 : 256;
+        Segment *grown = realloc(tl->segments, capacity * sizeof(Segment));
+        if (!grown) {
+            printf("Error allocating timeline\n");
+            exit(1);
         }
+        tl->segments = grown;
+        tl->capacity = capacity;
     }
+    Segment *seg = &tl->segments[tl->count++];
+    seg->process = process;
+    seg->start = start;
+    seg->end = end;
+}
+
+void timeline_free(Timeline *tl) {
+    free(tl->segments);
+    tl->segments = NULL;
+    tl->count = tl->capacity = 0;
+}
+
+void sort_by_arrival(ProcessList *pl) {
+    sort_processes_by_key(pl, offsetof(Process, arrival_time));
 }
 
 void sort_by_burst(ProcessList *pl) {
-    for (int i = 0; i < pl->count - 1; i++) {
-        for (int j = 0; j < pl->count - i - 1; j++) {
-            if (pl->processes[j].burst_time > pl->processes[j+1].burst_time) {
-                Process temp = pl->processes[j];
-                pl->processes[j] = pl->processes[j+1];
-                pl->processes[j+1] = temp;
-            }
-        }
-    }
+    sort_processes_by_key(pl, offsetof(Process, burst_time));
 }
 
 void sort_by_priority(ProcessList *pl) {
-    for (int i = 0; i < pl->count - 1; i++) {
-        for (int j = 0; j < pl->count - i - 1; j++) {
-            if (pl->processes[j].priority > pl->processes[j+1].priority) {
-                Process temp = pl->processes[j];
-                pl->processes[j] = pl->processes[j+1];
-                pl->processes[j+1] = temp;
+    sort_processes_by_key(pl, offsetof(Process, priority));
+}
+
+/* Stable LSD radix sort on one int field of Process. Keys are sorted
+   alongside their original index, one byte per pass, and the records
+   are gathered once at the end, so equal keys keep their input order
+   exactly as the old bubble sorts did. */
+void sort_processes_by_key(ProcessList *pl, size_t key_offset) {
+    int n = pl->count;
+    if (n < 2) return;
+
+    SortEntry *entries = malloc(n * sizeof(SortEntry));
+    SortEntry *scratch = malloc(n * sizeof(SortEntry));
+    if (!entries || !scratch) {
+        printf("Error allocating sort buffers\n");
+        exit(1);
+    }
+
+    bool sorted = true;
+    for (int i = 0; i < n; i++) {
+        int key = *(const int *)((const char *)&pl->processes[i] + key_offset);
+        entries[i].key = (unsigned int)key ^ 0x80000000u;
+        entries[i].idx = i;
+        if (i > 0 && entries[i].key < entries[i - 1].key) {
+            sorted = false;
+        }
+    }
+
+    if (!sorted) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            int counts[256] = {0};
+            for (int i = 0; i < n; i++) {
+                counts[(entries[i].key >> shift) & 0xFF]++;
+            }
+            if (counts[(entries[0].key >> shift) & 0xFF] == n) continue;
+
+            int offset = 0;
+            for (int b = 0; b < 256; b++) {
+                int c = counts[b];
+                counts[b] = offset;
+                offset += c;
             }
+            for (int i = 0; i < n; i++) {
+                scratch[counts[(entries[i].key >> shift) & 0xFF]++] = entries[i];
+            }
+            SortEntry *tmp = entries;
+            entries = scratch;
+            scratch = tmp;
+        }
+
+        Process *ordered = malloc(pl->capacity * sizeof(Process));
+        if (!ordered) {
+            printf("Error allocating sort buffers\n");
+            exit(1);
+        }
+        for (int i = 0; i < n; i++) {
+            ordered[i] = pl->processes[entries[i].idx];
         }
+        free(pl->processes);
+        pl->processes = ordered;
     }
+
+    free(entries);
+    free(scratch);
 }
 
+/* CPU.c's algorithms are specializations of the policy engine over
+   Process, recording their runs in the list's timeline. Energy is left
+   to timeline_energy(), so the loops carry no energy model. Preemptive
+   policies reset start_time at every dispatch and mark a preempted
+   process's completion_time, as their hand-written loops used to. */
+#define ENGINE_TASK Process
+#define ENGINE_ARRIVAL(p) ((p)->arrival_time)
+#define ENGINE_BURST(p) ((p)->burst_time)
+#define ENGINE_REMAINING(p) ((p)->remaining_time)
+#define ENGINE_PRIORITY(p) ((p)->priority)
+#define ENGINE_CONTEXT Timeline
+#define ENGINE_ON_DISPATCH(i, time, first) \
+    do { if (ENGINE_PREEMPTIVE || (first)) tasks[i].start_time = (time); } while (0)
+#define ENGINE_ON_PREEMPT(i, time) \
+    do { if (ENGINE_PREEMPTIVE) tasks[i].completion_time = (time); } while (0)
+#define ENGINE_ON_COMPLETE(i, time) \
+    do { \
+        Process *done = &tasks[i]; \
+        done->completion_time = (time); \
+        done->turnaround_time = done->completion_time - done->arrival_time; \
+        done->waiting_time = done->turnaround_time - done->burst_time; \
+    } while (0)
+#define ENGINE_ON_RUN(i, start, end) timeline_append(context, (i), (start), (end))
+#define ENGINE_PREFIX engine_
+#define ENGINE_CATALOG_ENERGY NONE
+#include "policy_catalog.h"
+
 void fcfs(ProcessList *pl) {
+    EngineStats stats;
     sort_by_arrival(pl);
-    
-    int current_time = 0;
-    for (int i = 0; i < pl->count; i++) {
-        Process *p = &pl->processes[i];
-        
-        if (current_time < p->arrival_time) {
-            current_time = p->arrival_time;
-        }
-        
-        p->start_time = current_time;
-        p->completion_time = current_time + p->burst_time;
-        p->turnaround_time = p->completion_time - p->arrival_time;
-        p->waiting_time = p->start_time - p->arrival_time;
-        
-        current_time = p->completion_time;
-    }
+    timeline_clear(&pl->timeline);
+    engine_fcfs(pl->processes, pl->count, 0, &pl->timeline, &stats);
 }
 
 void sjf(ProcessList *pl) {
+    EngineStats stats;
     sort_by_arrival(pl);
-    
-    int current_time = 0;
-    int completed = 0;
-    bool is_completed[MAX_PROCESSES] = {false};
-    
-    while (completed != pl->count) {
-        int idx = -1;
-        int min_burst = INT_MAX;
-        
-        for (int i = 0; i < pl->count; i++) {
-            if (!is_completed[i] && pl->processes[i].arrival_time <= current_time) {
-                if (pl->processes[i].burst_time < min_burst) {
-                    min_burst = pl->processes[i].burst_time;
-                    idx = i;
-                }
-                if (pl->processes[i].burst_time == min_burst) {
-                    if (pl->processes[i].arrival_time < pl->processes[idx].arrival_time) {
-                        idx = i;
-                    }
-                }
-            }
-        }
-        
-        if (idx != -1) {
-            Process *p = &pl->processes[idx];
-            p->start_time = current_time;
-            p->completion_time = current_time + p->burst_time;
-            p->turnaround_time = p->completion_time - p->arrival_time;
-            p->waiting_time = p->start_time - p->arrival_time;
-            
-            is_completed[idx] = true;
-            completed++;
-            current_time = p->completion_time;
-        } else {
-            current_time++;
-        }
-    }
+    timeline_clear(&pl->timeline);
+    engine_sjf(pl->processes, pl->count, 0, &pl->timeline, &stats);
 }
 
 void srtf(ProcessList *pl) {
+    EngineStats stats;
     sort_by_arrival(pl);
-    
-    int current_time = 0;
-    int completed = 0;
-    int prev = -1;
-
-    for (int i = 0; i < pl->count; i++) {
-        pl->processes[i].remaining_time = pl->processes[i].burst_time;
-    }
-    
-    while (completed != pl->count) {
-        int idx = -1;
-        int min_remaining = INT_MAX;
-        
-        for (int i = 0; i < pl->count; i++) {
-            if (pl->processes[i].arrival_time <= current_time && 
-                pl->processes[i].remaining_time > 0 && 
-                pl->processes[i].remaining_time < min_remaining) {
-                min_remaining = pl->processes[i].remaining_time;
-                idx = i;
-            }
-        }
-        
-        if (idx != -1) {
-            if (prev != idx) {
-                if (prev != -1 && pl->processes[prev].remaining_time > 0) {
-                    pl->processes[prev].completion_time = current_time;
-                }
-                pl->processes[idx].start_time = current_time;
-                prev = idx;
-            }
-            
-            pl->processes[idx].remaining_time--;
-            current_time++;
-            
-            if (pl->processes[idx].remaining_time == 0) {
-                completed++;
-                pl->processes[idx].completion_time = current_time;
-                pl->processes[idx].turnaround_time = 
-                    pl->processes[idx].completion_time - pl->processes[idx].arrival_time;
-                pl->processes[idx].waiting_time = 
-                    pl->processes[idx].turnaround_time - pl->processes[idx].burst_time;
-            }
-        } else {
-            current_time++;
-        }
-    }
+    timeline_clear(&pl->timeline);
+    engine_srtf(pl->processes, pl->count, 0, &pl->timeline, &stats);
 }
 
 void round_robin(ProcessList *pl, int quantum) {
+    EngineStats stats;
     sort_by_arrival(pl);
-    
-    int current_time = 0;
-    int completed = 0;
-    int queue[MAX_PROCESSES];
-    int front = 0, rear = -1;
-    bool is_queued[MAX_PROCESSES] = {false};
-   
-    for (int i = 0; i < pl->count; i++) {
-        pl->processes[i].remaining_time = pl->processes[i].burst_time;
-    }
-    
- 
-    for (int i = 0; i < pl->count; i++) {
-        if (pl->processes[i].arrival_time <= current_time) {
-            queue[++rear] = i;
-            is_queued[i] = true;
-        }
-    }
-    
-    while (completed != pl->count) {
-        if (front > rear) {
-            current_time++;
-           
-            for (int i = 0; i < pl->count; i++) {
-                if (!is_queued[i] && pl->processes[i].arrival_time <= current_time) {
-                    queue[++rear] = i;
-                    is_queued[i] = true;
-                }
-            }
-            continue;
-        }
-        
-        int idx = queue[front++];
-        Process *p = &pl->processes[idx];
-        
-        if (p->remaining_time == p->burst_time) {
-            p->start_time = current_time;
-        }
-        
-        if (p->remaining_time > quantum) {
-            current_time += quantum;
-            p->remaining_time -= quantum;
-            
-        
-            for (int i = 0; i < pl->count; i++) {
-                if (!is_queued[i] && pl->processes[i].arrival_time <= current_time) {
-                    queue[++rear] = i;
-                    is_queued[i] = true;
-                }
-            }
-            
-            queue[++rear] = idx;
-        } else {
-            current_time += p->remaining_time;
-            p->remaining_time = 0;
-            p->completion_time = current_time;
-            p->turnaround_time = p->completion_time - p->arrival_time;
-            p->waiting_time = p->turnaround_time - p->burst_time;
-            completed++;
-            
-         
-            for (int i = 0; i < pl->count; i++) {
-                if (!is_queued[i] && pl->processes[i].arrival_time <= current_time) {
-                    queue[++rear] = i;
-                    is_queued[i] = true;
-                }
-            }
-        }
-    }
+    timeline_clear(&pl->timeline);
+    engine_round_robin(pl->processes, pl->count, quantum < 1 ? 1 : quantum, &pl->timeline, &stats);
 }
 
 void priority_preemptive(ProcessList *pl) {
+    EngineStats stats;
     sort_by_arrival(pl);
-    
-    int current_time = 0;
-    int completed = 0;
-    int prev = -1;
-    
- 
-    for (int i = 0; i < pl->count; i++) {
-        pl->processes[i].remaining_time = pl->processes[i].burst_time;
+    timeline_clear(&pl->timeline);
+    engine_priority_preemptive(pl->processes, pl->count, 0, &pl->timeline, &stats);
+}
+
+void priority_non_preemptive(ProcessList *pl) {
+    EngineStats stats;
+    sort_by_arrival(pl);
+    timeline_clear(&pl->timeline);
+    engine_priority_non_preemptive(pl->processes, pl->count, 0, &pl->timeline, &stats);
+}
+
+/* Energy-aware multi-level feedback queue. Arrivals enter level 0,
+   level L runs slices of quantum << L, and a process that uses its whole
+   slice drops a level; every MLFQ_BOOST_QUANTA base quanta all queued
+   processes return to level 0. A process whose remainder fits in one
+   and a half slices finishes instead of being requeued, which saves the
+   context switch (and its transition penalty) of coming back for it.
+   Queues are FIFO lists, and a boost splices them and bumps an epoch
+   instead of touching each process, so every decision is O(MLFQ_LEVELS). */
+void mlfq(ProcessList *pl, int quantum) {
+    EngineStats stats;
+    sort_by_arrival(pl);
+    timeline_clear(&pl->timeline);
+    engine_mlfq(pl->processes, pl->count, quantum < 1 ? 1 : quantum, &pl->timeline, &stats);
+}
+
+const char *algorithm_name(int choice) {
+    switch (choice) {
+        case 1: return "FCFS";
+        case 2: return "SJF";
+        case 3: return "SRTF";
+        case 4: return "RR";
+        case 5: return "Priority (P)";
+        case 6: return "Priority (NP)";
+        case 7: return "MLFQ";
+        default: return "?";
     }
-    
-    while (completed != pl->count) {
-        int idx = -1;
-        int highest_priority = INT_MAX;
-        
-        for (int i = 0; i < pl->count; i++) {
-            if (pl->processes[i].arrival_time <= current_time && 
-                pl->processes[i].remaining_time > 0 && 
-                pl->processes[i].priority < highest_priority) {
-                highest_priority = pl->processes[i].priority;
-                idx = i;
-            }
-        }
-        
-        if (idx != -1) {
-            if (prev != idx) {
-                if (prev != -1 && pl->processes[prev].remaining_time > 0) {
-                    pl->processes[prev].completion_time = current_time;
-                }
-                pl->processes[idx].start_time = current_time;
-                prev = idx;
-            }
-            
-            pl->processes[idx].remaining_time--;
-            current_time++;
-            
-            if (pl->processes[idx].remaining_time == 0) {
-                completed++;
-                pl->processes[idx].completion_time = current_time;
-                pl->processes[idx].turnaround_time = 
-                    pl->processes[idx].completion_time - pl->processes[idx].arrival_time;
-                pl->processes[idx].waiting_time = 
-                    pl->processes[idx].turnaround_time - pl->processes[idx].burst_time;
-            }
-        } else {
-            current_time++;
+}
+
+void run_algorithm(ProcessList *pl, int choice, int quantum) {
+    switch (choice) {
+        case 1: fcfs(pl); break;
+        case 2: sjf(pl); break;
+        case 3: srtf(pl); break;
+        case 4: round_robin(pl, quantum); break;
+        case 5: priority_preemptive(pl); break;
+        case 6: priority_non_preemptive(pl); break;
+        case 7: mlfq(pl, quantum); break;
+    }
+}
+
+/* Each worker keeps one private copy of the process list and refreshes
+   it from the shared, read-only base before every job, so the dataset is
+   loaded and sorted once no matter how many jobs run. */
+void *sweep_worker(void *arg) {
+    SweepPool *pool = arg;
+    const ProcessList *base = pool->base;
+    ProcessList pl = {0};
+    reserve_processes(&pl, base->count);
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        int j = pool->next_job++;
+        pthread_mutex_unlock(&pool->lock);
+        if (j >= pool->job_count) break;
+
+        SweepJob *job = &pool->jobs[j];
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        memcpy(pl.processes, base->processes, base->count * sizeof(Process));
+        pl.count = base->count;
+        run_algorithm(&pl, job->choice, job->quantum);
+
+        long long total_tat = 0, total_wt = 0;
+        job->max_waiting = 0;
+        job->makespan = 0;
+        for (int i = 0; i < pl.count; i++) {
+            Process *p = &pl.processes[i];
+            total_tat += p->turnaround_time;
+            total_wt += p->waiting_time;
+            if (p->waiting_time > job->max_waiting) job->max_waiting = p->waiting_time;
+            if (p->completion_time > job->makespan) job->makespan = p->completion_time;
         }
+        job->avg_turnaround = pl.count ? (double)total_tat / pl.count : 0;
+        job->avg_waiting = pl.count ? (double)total_wt / pl.count : 0;
+        job->energy = timeline_energy(&pl).energy;
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        job->seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
     }
+
+    free_process_list(&pl);
+    return NULL;
 }
 
-void priority_non_preemptive(ProcessList *pl) {
-    sort_by_arrival(pl);
-    
-    int current_time = 0;
-    int completed = 0;
-    bool is_completed[MAX_PROCESSES] = {false};
-    
-    while (completed != pl->count) {
-        int idx = -1;
-        int highest_priority = INT_MAX;
-        
-        for (int i = 0; i < pl->count; i++) {
-            if (!is_completed[i] && pl->processes[i].arrival_time <= current_time) {
-                if (pl->processes[i].priority < highest_priority) {
-                    highest_priority = pl->processes[i].priority;
-                    idx = i;
-                }
-                if (pl->processes[i].priority == highest_priority) {
-                    if (pl->processes[i].arrival_time < pl->processes[idx].arrival_time) {
-                        idx = i;
-                    }
-                }
+/* Runs every algorithm, with round robin and MLFQ once per quantum in
+   [q_min, q_max], on a pool of threads and prints one comparison table. */
+int run_sweep(const char *filename, int q_min, int q_max, int q_step, int threads) {
+    if (q_min < 1 || q_max < q_min || q_step < 1) {
+        printf("Invalid quantum range %d..%d step %d\n", q_min, q_max, q_step);
+        return 0;
+    }
+    if (threads < 1) threads = 1;
+
+    ProcessList base = {0};
+    load_dataset(&base, filename);
+    sort_by_arrival(&base);
+
+    SweepPool pool;
+    pool.base = &base;
+    pool.job_count = 5 + 2 * ((q_max - q_min) / q_step + 1);
+    pool.jobs = calloc(pool.job_count, sizeof(SweepJob));
+    pool.next_job = 0;
+    pthread_mutex_init(&pool.lock, NULL);
+    if (!pool.jobs) {
+        printf("Error allocating sweep jobs\n");
+        exit(1);
+    }
+
+    int j = 0;
+    for (int choice = 1; choice <= 7; choice++) {
+        if (choice == 4 || choice == 7) {
+            for (int q = q_min; q <= q_max; q += q_step) {
+                pool.jobs[j].choice = choice;
+                pool.jobs[j++].quantum = q;
             }
-        }
-        
-        if (idx != -1) {
-            Process *p = &pl->processes[idx];
-            p->start_time = current_time;
-            p->completion_time = current_time + p->burst_time;
-            p->turnaround_time = p->completion_time - p->arrival_time;
-            p->waiting_time = p->start_time - p->arrival_time;
-            
-            is_completed[idx] = true;
-            completed++;
-            current_time = p->completion_time;
         } else {
-            current_time++;
+            pool.jobs[j++].choice = choice;
         }
     }
+    if (threads > pool.job_count) threads = pool.job_count;
+
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    if (!workers) {
+        printf("Error allocating sweep threads\n");
+        exit(1);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_create(&workers[t], NULL, sweep_worker, &pool);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    printf("Sweep of %d processes from %s (%d jobs, %d threads)\n\n",
+           base.count, filename, pool.job_count, threads);
+    printf("Algorithm     | Quantum | Avg TAT    | Avg Wait   | Max Wait | Makespan   | Energy (mJ)  | Time (s)\n");
+    printf("--------------|---------|------------|------------|----------|------------|--------------|---------\n");
+    for (j = 0; j < pool.job_count; j++) {
+        SweepJob *job = &pool.jobs[j];
+        char quantum[16] = "-";
+        if (job->choice == 4 || job->choice == 7) snprintf(quantum, sizeof(quantum), "%d", job->quantum);
+        printf("%-13s | %7s | %10.2f | %10.2f | %8d | %10d | %12lld | %8.3f\n",
+               algorithm_name(job->choice), quantum, job->avg_turnaround, job->avg_waiting,
+               job->max_waiting, job->makespan, job->energy, job->seconds);
+    }
+
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+    free(pool.jobs);
+    free_process_list(&base);
+    return 1;
 }
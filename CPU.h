@@ -0,0 +1,122 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define DATASET_CHUNK_ROWS 65536
+#define GANTT_COLUMNS 40
+#define MLFQ_LEVELS 4
+#define MLFQ_BOOST_QUANTA 64   /* every process returns to level 0 this often */
+
+typedef struct {
+    char name[10];
+    int arrival_time;
+    int burst_time;
+    int priority;
+    int start_time;
+    int completion_time;
+    int turnaround_time;
+    int waiting_time;
+    int remaining_time;
+} Process;
+
+/* One contiguous run of a process on the CPU. Back-to-back runs of the
+   same process are merged, so the timeline is run-length encoded. */
+typedef struct {
+    int process;   /* index into ProcessList.processes */
+    int start;
+    int end;
+} Segment;
+
+typedef struct {
+    Segment *segments;
+    int count;
+    int capacity;
+} Timeline;
+
+typedef struct {
+    Process *processes;
+    int count;
+    int capacity;
+    Timeline timeline;
+} ProcessList;
+
+typedef struct {
+    const char *filename;
+    char *data;
+    size_t size;
+    size_t pos;
+    int line;
+    int errors;
+    bool mapped;
+} DatasetReader;
+
+typedef struct {
+    unsigned int key;
+    int idx;
+} SortEntry;
+
+typedef struct {
+    int choice;
+    int quantum;
+    double avg_turnaround;
+    double avg_waiting;
+    int max_waiting;
+    int makespan;
+    long long energy;
+    double seconds;
+} SweepJob;
+
+typedef struct {
+    long long energy;       /* mJ, under the model in energy_model.h */
+    int context_switches;
+    int idle_periods;
+} EnergyReport;
+
+typedef struct {
+    const ProcessList *base;
+    SweepJob *jobs;
+    int job_count;
+    int next_job;
+    pthread_mutex_t lock;
+} SweepPool;
+
+void load_dataset(ProcessList *pl, const char *filename);
+void load_binary_dataset(ProcessList *pl, const char *filename);
+int save_text_dataset(ProcessList *pl, const char *filename);
+int save_binary_dataset(ProcessList *pl, const char *filename);
+int convert_dataset(const char *input, const char *output);
+int open_dataset(DatasetReader *r, const char *filename);
+int read_dataset_chunk(DatasetReader *r, ProcessList *pl, int max_rows);
+void close_dataset(DatasetReader *r);
+bool parse_int_field(const char **cursor, const char *end, int *out);
+Process *append_process(ProcessList *pl);
+void reserve_processes(ProcessList *pl, int capacity);
+void free_process_list(ProcessList *pl);
+void print_results(ProcessList *pl);
+void calculate_metrics(ProcessList *pl);
+void fcfs(ProcessList *pl);
+void sjf(ProcessList *pl);
+void srtf(ProcessList *pl);
+void round_robin(ProcessList *pl, int quantum);
+void priority_preemptive(ProcessList *pl);
+void priority_non_preemptive(ProcessList *pl);
+void mlfq(ProcessList *pl, int quantum);
+EnergyReport timeline_energy(const ProcessList *pl);
+void print_gantt_chart(ProcessList *pl);
+void timeline_clear(Timeline *tl);
+void timeline_append(Timeline *tl, int process, int start, int end);
+void timeline_free(Timeline *tl);
+void sort_by_arrival(ProcessList *pl);
+void sort_by_burst(ProcessList *pl);
+void sort_by_priority(ProcessList *pl);
+void sort_processes_by_key(ProcessList *pl, size_t key_offset);
+const char *algorithm_name(int choice);
+void run_algorithm(ProcessList *pl, int choice, int quantum);
+void *sweep_worker(void *arg);
+int run_sweep(const char *filename, int q_min, int q_max, int q_step, int threads);
+
+#endif
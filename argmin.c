@@ -0,0 +1,42 @@
+#include <string.h>
+#include "argmin.h"
+
+ArgminKernel argmin_kernel = ARGMIN_SCALAR;
+static const char *kernel_name = "scalar";
+
+/* Returns 1 if the named kernel exists and this CPU can run it. */
+int argmin_set_kernel(const char *name) {
+    if (strcmp(name, "scalar") == 0) {
+        argmin_kernel = ARGMIN_SCALAR;
+        kernel_name = "scalar";
+        return 1;
+    }
+#ifdef ARGMIN_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse4.2") == 0 && __builtin_cpu_supports("sse4.2")) {
+        argmin_kernel = ARGMIN_SSE42;
+        kernel_name = "sse4.2";
+        return 1;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        argmin_kernel = ARGMIN_AVX2;
+        kernel_name = "avx2";
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+const char *argmin_kernel_name(void) {
+    return kernel_name;
+}
+
+/* Picks the kernel before main() runs, so worker threads never race on
+   the choice. SSE4.2 is preferred: for eight keys the reduction chain is
+   the same length either way, and the 256-bit version measured slower. */
+__attribute__((constructor))
+static void argmin_select_best(void) {
+    if (!argmin_set_kernel("sse4.2")) {
+        argmin_set_kernel("avx2");
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef ARGMIN_H
+#define ARGMIN_H
+
+#include <stdint.h>
+
+/*
+ * Position of the smallest of eight consecutive signed 64-bit keys.
+ *
+ * Used by the ready queue in ready_queue.c to pick the smallest child of
+ * an 8-ary heap node. Keys are unique, so the result is unambiguous. The
+ * kernels are inline so the queue can build one pop per kernel with the
+ * kernel compiled in; argmin_kernel names the one to use. The SSE4.2
+ * kernel is selected when the CPU supports it, otherwise the scalar
+ * loop; argmin_set_kernel() switches to "scalar", "sse4.2" or "avx2"
+ * for benchmarking.
+ */
+
+#define ARGMIN_WIDTH 8
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARGMIN_X86 1
+#endif
+
+typedef enum {
+    ARGMIN_SCALAR,
+    ARGMIN_SSE42,
+    ARGMIN_AVX2
+} ArgminKernel;
+
+extern ArgminKernel argmin_kernel;
+
+int argmin_set_kernel(const char *name);
+const char *argmin_kernel_name(void);
+
+static inline int argmin_scalar(const int64_t *keys) {
+    int best = 0;
+    for (int i = 1; i < ARGMIN_WIDTH; i++) {
+        if (keys[i] < keys[best]) best = i;
+    }
+    return best;
+}
+
+#ifdef ARGMIN_X86
+__attribute__((target("sse4.2")))
+static inline __m128i argmin_min_epi64_sse(__m128i a, __m128i b) {
+    return _mm_blendv_epi8(a, b, _mm_cmpgt_epi64(a, b));
+}
+
+/* Reduces to the minimum in every lane, then finds which input lane
+   holds it with one compare per vector. */
+__attribute__((target("sse4.2")))
+static inline int argmin_sse42(const int64_t *keys) {
+    __m128i a = _mm_loadu_si128((const __m128i *)keys);
+    __m128i b = _mm_loadu_si128((const __m128i *)(keys + 2));
+    __m128i c = _mm_loadu_si128((const __m128i *)(keys + 4));
+    __m128i d = _mm_loadu_si128((const __m128i *)(keys + 6));
+    __m128i m = argmin_min_epi64_sse(argmin_min_epi64_sse(a, b), argmin_min_epi64_sse(c, d));
+    m = argmin_min_epi64_sse(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, m))) |
+               _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(b, m))) << 2 |
+               _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(c, m))) << 4 |
+               _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(d, m))) << 6;
+    return __builtin_ctz(mask);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i argmin_min_epi64_avx2(__m256i a, __m256i b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+/* Folds to 128 bits for the last two steps, which avoids the slower
+   cross-lane permutes, and broadcasts the minimum back for the compare. */
+__attribute__((target("avx2")))
+static inline int argmin_avx2(const int64_t *keys) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)keys);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(keys + 4));
+    __m256i m = argmin_min_epi64_avx2(a, b);
+    __m128i lo = _mm256_castsi256_si128(m), hi = _mm256_extracti128_si256(m, 1);
+    __m128i h = _mm_blendv_epi8(lo, hi, _mm_cmpgt_epi64(lo, hi));
+    __m128i s = _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2));
+    h = _mm_blendv_epi8(h, s, _mm_cmpgt_epi64(h, s));
+    m = _mm256_broadcastq_epi64(h);
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, m))) |
+               _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(b, m))) << 4;
+    return __builtin_ctz(mask);
+}
+#endif
+
+#endif
@@ -0,0 +1,1002 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "CPU.h"
+#include "energy_scheduler.h"
+#include "workload.h"
+#include "event_log.h"
+#include "submit_queue.h"
+#include "argmin.h"
+#include "policy_engine.h"
+#include "checkpoint.h"
+
+#define BENCH_SEED 12345
+#define BENCH_QUANTUM 10
+#define BENCH_CORES 4
+#define DEFAULT_MAX_TASKS 10000000
+#define DEFAULT_BUDGET_SECONDS 10.0
+#define DEFAULT_RESULTS_FILE "bench_results.csv"
+#define DEFAULT_MAX_PRODUCERS 8
+#define DEFAULT_SUBMIT_TASKS 4000000
+#define SUBMIT_QUEUE_SLOTS 65536
+#define SUBMIT_DRAIN_BATCH 4096
+#define DEFAULT_KERNEL_TASKS 10000000
+#define DEFAULT_ENGINE_TASKS 1000000
+#define DEFAULT_REPLAY_TASKS 10000000
+#define DEFAULT_CHECKPOINT_SECONDS 10.0
+#define CHECKPOINT_POLL_STEPS 1024    /* batches between checks of the clock */
+#define CHECK_TASKS 10000             /* generated dataset of the golden results */
+#define DEFAULT_CHECK_SLACK 20.0      /* percent slower than the baseline allowed */
+#define DEFAULT_BASELINE_FILE "bench_baseline.csv"
+#define CHECK_TIMED_TASKS 1000000     /* smaller baseline rows are mostly noise */
+#define CHECK_TIMING_RUNS 5           /* a timed row keeps its best run */
+#define DIGEST_INIT 14695981039346656037ULL
+
+typedef enum {
+    BENCH_CPU,        /* CPU.c algorithm, arg = menu choice */
+    BENCH_ENERGY,     /* schedule_tasks() */
+    BENCH_MULTICORE   /* schedule_tasks_multicore(), arg = core count */
+} BenchKind;
+
+typedef struct {
+    const char *name;
+    BenchKind kind;
+    int arg;
+    LogLevel log_level;   /* energy schedulers only */
+} BenchScheduler;
+
+typedef struct {
+    double seconds;
+    long long checksum;
+} BenchSample;
+
+typedef struct {
+    SubmitQueue *queue;
+    const WorkloadTask *workload;
+    int first;
+    int count;
+} Producer;
+
+static const BenchScheduler schedulers[] = {
+    {"fcfs", BENCH_CPU, 1, LOG_QUIET},
+    {"sjf", BENCH_CPU, 2, LOG_QUIET},
+    {"srtf", BENCH_CPU, 3, LOG_QUIET},
+    {"round_robin", BENCH_CPU, 4, LOG_QUIET},
+    {"priority_preemptive", BENCH_CPU, 5, LOG_QUIET},
+    {"priority_non_preemptive", BENCH_CPU, 6, LOG_QUIET},
+    {"mlfq", BENCH_CPU, 7, LOG_QUIET},
+    {"schedule_tasks", BENCH_ENERGY, 0, LOG_QUIET},
+    {"schedule_tasks_multicore", BENCH_MULTICORE, BENCH_CORES, LOG_QUIET},
+    {"schedule_tasks_multicore_logged", BENCH_MULTICORE, BENCH_CORES, LOG_EVENTS},
+};
+
+/* The policy catalog over Process once per energy model, so every
+   policy can be run under every simulator's energy model. Deadlines are
+   3x the burst after arrival, the middle of simulation_engine.c's range. */
+#define ENGINE_TASK Process
+#define ENGINE_ARRIVAL(p) ((p)->arrival_time)
+#define ENGINE_BURST(p) ((p)->burst_time)
+#define ENGINE_REMAINING(p) ((p)->remaining_time)
+#define ENGINE_PRIORITY(p) ((p)->priority)
+#define ENGINE_DEADLINE(p) ((p)->arrival_time + 3 * (p)->burst_time)
+#define ENGINE_PREFIX timeline_
+#define ENGINE_CATALOG_ENERGY TIMELINE
+#include "policy_catalog.h"
+#define ENGINE_PREFIX batch_
+#define ENGINE_CATALOG_ENERGY BATCH
+#include "policy_catalog.h"
+#define ENGINE_PREFIX dvfs_
+#define ENGINE_CATALOG_ENERGY DVFS
+#include "policy_catalog.h"
+
+#define ENGINE_MODELS 3
+
+typedef void (*EnginePolicy)(Process *tasks, int count, int quantum, void *context, EngineStats *stats);
+
+typedef struct {
+    const char *name;
+    EnginePolicy run[ENGINE_MODELS];   /* timeline, batch, dvfs */
+} EngineEntry;
+
+#define ENGINE_ENTRY(policy) {#policy, {timeline_##policy, batch_##policy, dvfs_##policy}}
+
+static const EngineEntry engine_policies[] = {
+    ENGINE_ENTRY(fcfs),
+    ENGINE_ENTRY(sjf),
+    ENGINE_ENTRY(srtf),
+    ENGINE_ENTRY(round_robin),
+    ENGINE_ENTRY(priority_preemptive),
+    ENGINE_ENTRY(priority_non_preemptive),
+    ENGINE_ENTRY(mlfq),
+    ENGINE_ENTRY(batch),
+    ENGINE_ENTRY(edf),
+};
+
+double elapsed_seconds(struct timespec *start, struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+void workload_processes(ProcessList *pl, const WorkloadTask *workload, int num_tasks) {
+    reserve_processes(pl, num_tasks);
+    for (int i = 0; i < num_tasks; i++) {
+        Process *p = append_process(pl);
+        snprintf(p->name, sizeof(p->name), "P%d", workload[i].id);
+        p->arrival_time = workload[i].arrival_time;
+        p->burst_time = (int)workload[i].duration;
+        p->priority = workload[i].priority;
+        p->remaining_time = p->burst_time;
+    }
+}
+
+/* Builds the scheduler's input from a fixed-seed workload, then times
+   only the scheduling call; a logged run's events are formatted after
+   the clock stops, when the log is flushed. The checksum lets runs be
+   compared for identical results as well as speed. */
+BenchSample run_scheduler(const BenchScheduler *bs, int num_tasks) {
+    BenchSample sample = {0, 0};
+    struct timespec start, end;
+    int seed = BENCH_SEED;
+    WorkloadTask *workload = generate_workload(num_tasks, &seed);
+    if (!workload) exit(1);
+
+    if (bs->kind == BENCH_CPU) {
+        ProcessList pl = {0};
+        workload_processes(&pl, workload, num_tasks);
+        free_workload(workload);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        run_algorithm(&pl, bs->arg, BENCH_QUANTUM);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        for (int i = 0; i < pl.count; i++) {
+            sample.checksum += pl.processes[i].completion_time;
+        }
+        free_process_list(&pl);
+    } else {
+        Scheduler sched;
+        init_scheduler(&sched);
+        for (int i = 0; i < num_tasks; i++) {
+            add_task(&sched, workload[i].id, (int)workload[i].duration,
+                     workload[i].arrival_time, workload[i].priority);
+        }
+        free_workload(workload);
+
+        log_flush();
+        if (bs->kind == BENCH_ENERGY) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            schedule_tasks(&sched);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+        } else {
+            MultiCoreScheduler mc;
+            init_multicore(&mc, bs->arg, PLACE_SPREAD);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            schedule_tasks_multicore(&sched, &mc);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            free_multicore(&mc);
+        }
+        log_flush();
+        sample.checksum = sched.total_energy;
+        free_scheduler(&sched);
+    }
+
+    sample.seconds = elapsed_seconds(&start, &end);
+    return sample;
+}
+
+/* Each measurement runs in a forked child so peak RSS is per run and a
+   run that blows far past the budget can be killed without losing the
+   results gathered so far. Returns the status string for the report. */
+const char *measure(const BenchScheduler *bs, int num_tasks, double budget,
+                    BenchSample *sample, long *peak_rss_kb) {
+    int fds[2];
+    if (pipe(fds) != 0) return "failed";
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return "failed";
+    if (pid == 0) {
+        close(fds[0]);
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDOUT_FILENO);
+        log_open("/dev/null", bs->log_level, bs->log_level == LOG_EVENTS);
+        alarm((unsigned int)(budget * 3) + 1);
+        BenchSample s = run_scheduler(bs, num_tasks);
+        ssize_t written = write(fds[1], &s, sizeof(s));
+        _exit(written == sizeof(s) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], sample, sizeof(BenchSample));
+    close(fds[0]);
+
+    int status;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    *peak_rss_kb = usage.ru_maxrss;
+
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) return "timeout";
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || got != sizeof(BenchSample)) return "failed";
+    return sample->seconds > budget ? "over_budget" : "ok";
+}
+
+void *producer_main(void *arg) {
+    Producer *p = arg;
+    for (int i = p->first; i < p->first + p->count; i++) {
+        const WorkloadTask *w = &p->workload[i];
+        TaskSubmission task = {w->id, (int)w->duration, w->arrival_time, w->priority};
+        while (!submit_queue_push(p->queue, &task)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* Producers split the workload and push concurrently while this thread
+   drains into a Scheduler. The clock stops once every task has reached
+   the scheduler; the checksum (sum of task ids) shows none were lost. */
+BenchSample run_submit_stress(int producers, int num_tasks, const WorkloadTask *workload) {
+    BenchSample sample = {0, 0};
+    struct timespec start, end;
+    SubmitQueue queue;
+    Producer workers[producers];
+    pthread_t threads[producers];
+    Scheduler sched;
+
+    if (!submit_queue_init(&queue, SUBMIT_QUEUE_SLOTS)) exit(1);
+    init_scheduler(&sched);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < producers; i++) {
+        workers[i].queue = &queue;
+        workers[i].workload = workload;
+        workers[i].first = (long long)num_tasks * i / producers;
+        workers[i].count = (long long)num_tasks * (i + 1) / producers - workers[i].first;
+        pthread_create(&threads[i], NULL, producer_main, &workers[i]);
+    }
+    while (sched.task_count < num_tasks) {
+        if (submit_queue_drain(&queue, &sched, SUBMIT_DRAIN_BATCH) == 0) {
+            sched_yield();
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    for (int i = 0; i < producers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < sched.task_count; i++) {
+        sample.checksum += sched.tasks[i].task_id;
+    }
+    sample.seconds = elapsed_seconds(&start, &end);
+    free_scheduler(&sched);
+    submit_queue_free(&queue);
+    return sample;
+}
+
+int submit_benchmark(int max_producers, int num_tasks) {
+    int seed = BENCH_SEED;
+    WorkloadTask *workload = generate_workload(num_tasks, &seed);
+    if (!workload) return 1;
+    log_open(NULL, LOG_QUIET, 0);
+
+    printf("Submission Queue Stress (%d tasks, %d slots)\n", num_tasks, SUBMIT_QUEUE_SLOTS);
+    printf("Producers | Time (s)  | Mtasks/s | Speedup | Checksum\n");
+    printf("----------|-----------|----------|---------|-----------------\n");
+    double base = 0;
+    for (int producers = 1; producers <= max_producers; producers *= 2) {
+        BenchSample sample = run_submit_stress(producers, num_tasks, workload);
+        double rate = num_tasks / sample.seconds / 1e6;
+        if (producers == 1) base = rate;
+        printf("%9d | %9.4f | %8.2f | %6.2fx | %lld\n",
+               producers, sample.seconds, rate, rate / base, sample.checksum);
+    }
+
+    log_close();
+    free_workload(workload);
+    return 0;
+}
+
+/* Times the ready-queue schedulers once per argmin kernel this CPU can
+   run, so the SIMD child selection can be compared against scalar. */
+int kernel_benchmark(int num_tasks, double budget) {
+    static const char *kernels[] = {"scalar", "sse4.2", "avx2"};
+    printf("Ready Queue Kernels (%d tasks, seed %d)\n", num_tasks, BENCH_SEED);
+    printf("Scheduler                       | Kernel | Time (s)  | ns/task  | Status\n");
+    printf("--------------------------------|--------|-----------|----------|------------\n");
+    for (int s = 0; s < (int)(sizeof(schedulers) / sizeof(schedulers[0])); s++) {
+        const BenchScheduler *bs = &schedulers[s];
+        if (bs->kind != BENCH_CPU || bs->arg == 1 || bs->arg == 4 || bs->arg == 7) continue;
+        for (int k = 0; k < (int)(sizeof(kernels) / sizeof(kernels[0])); k++) {
+            if (!argmin_set_kernel(kernels[k])) continue;
+            BenchSample sample = {0, 0};
+            long peak_rss_kb = 0;
+            const char *status = measure(bs, num_tasks, budget, &sample, &peak_rss_kb);
+            printf("%-31s | %-6s | %9.4f | %8.1f | %s\n", bs->name, kernels[k],
+                   sample.seconds, sample.seconds * 1e9 / num_tasks, status);
+        }
+    }
+    return 0;
+}
+
+/* Runs every catalog policy under each energy model on one workload. A
+   specialization is chosen once per run; inside it nothing is called
+   indirectly. The time is that of the timeline-model run. */
+int engine_benchmark(int num_tasks) {
+    int seed = BENCH_SEED;
+    WorkloadTask *workload = generate_workload(num_tasks, &seed);
+    if (!workload) return 1;
+    ProcessList pl = {0};
+    workload_processes(&pl, workload, num_tasks);
+    free_workload(workload);
+    sort_by_arrival(&pl);
+
+    printf("Policy Engine (%d tasks, seed %d, quantum %d)\n", num_tasks, BENCH_SEED, BENCH_QUANTUM);
+    printf("Policy                  | Timeline (mJ) | Batch (mJ)    | DVFS (mJ)     | Makespan   | Misses   | Time (s)\n");
+    printf("------------------------|---------------|---------------|---------------|------------|----------|---------\n");
+    for (int e = 0; e < (int)(sizeof(engine_policies) / sizeof(engine_policies[0])); e++) {
+        const EngineEntry *entry = &engine_policies[e];
+        EngineStats stats[ENGINE_MODELS];
+        struct timespec start, end;
+        double seconds = 0;
+        for (int m = 0; m < ENGINE_MODELS; m++) {
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            entry->run[m](pl.processes, pl.count, BENCH_QUANTUM, NULL, &stats[m]);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            if (m == 0) seconds = elapsed_seconds(&start, &end);
+        }
+        printf("%-23s | %13.0f | %13.0f | %13.0f | %10d | %8d | %8.4f\n", entry->name,
+               stats[0].energy, stats[1].energy, stats[2].energy,
+               stats[0].makespan, stats[0].deadline_misses, seconds);
+    }
+    free_process_list(&pl);
+    return 0;
+}
+
+static volatile sig_atomic_t replay_interrupted;
+
+static void interrupt_replay(int sig) {
+    (void)sig;
+    replay_interrupted = 1;
+}
+
+/* Drains a fixed-seed workload through the single-core energy scheduler
+   (or, with `resume`, whatever the checkpoint file left unfinished),
+   checkpointing every `interval` seconds of run time when a file is
+   given, and once more on SIGINT before stopping. The final state is
+   printed in full so an interrupted and resumed run can be compared
+   with an uninterrupted one. */
+int replay_benchmark(int num_tasks, const char *checkpoint_file, double interval, int resume) {
+    Scheduler sched;
+    Checkpoint cp;
+    log_open(NULL, LOG_QUIET, 0);
+    if (resume) {
+        if (!checkpoint_resume(&cp, checkpoint_file, &sched)) return 1;
+        printf("Replay resumed from %s (generation %llu, %d tasks, clock %d ms)\n",
+               checkpoint_file, (unsigned long long)cp.generation, sched.task_count, sched.current_time);
+    } else {
+        int seed = BENCH_SEED;
+        WorkloadTask *workload = generate_workload(num_tasks, &seed);
+        if (!workload) return 1;
+        init_scheduler(&sched);
+        for (int i = 0; i < num_tasks; i++) {
+            add_task(&sched, workload[i].id, (int)workload[i].duration,
+                     workload[i].arrival_time, workload[i].priority);
+        }
+        free_workload(workload);
+        if (checkpoint_file && !checkpoint_create(&cp, checkpoint_file, &sched)) return 1;
+        printf("Replay (%d tasks, seed %d)\n", num_tasks, BENCH_SEED);
+    }
+    if (checkpoint_file) {
+        printf("Checkpointing to %s every %.1fs\n", checkpoint_file, interval);
+        signal(SIGINT, interrupt_replay);
+    }
+
+    struct timespec start, end, now, mark;
+    double checkpoint_seconds = 0;
+    int checkpoints = 0, steps = 0, ran;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    mark = start;
+    while ((ran = scheduler_step(&sched)) > 0) {
+        if (!checkpoint_file || (++steps % CHECKPOINT_POLL_STEPS != 0 && !replay_interrupted)) continue;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (elapsed_seconds(&mark, &now) < interval && !replay_interrupted) continue;
+        if (!checkpoint_save(&cp, &sched)) return 1;
+        clock_gettime(CLOCK_MONOTONIC, &mark);
+        checkpoint_seconds += elapsed_seconds(&now, &mark);
+        checkpoints++;
+        if (replay_interrupted) break;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = elapsed_seconds(&start, &end);
+
+    int completed = 0;
+    for (int i = 0; i < sched.task_count; i++) {
+        completed += sched.tasks[i].completed;
+    }
+    if (ran > 0) {
+        printf("Interrupted at clock %d ms; resume with: benchmark resume %s\n",
+               sched.current_time, checkpoint_file);
+    }
+    printf("Completed %d/%d tasks, clock %d ms, energy %lld mJ\n",
+           completed, sched.task_count, sched.current_time, sched.total_energy);
+    SleepState states[MAX_SLEEP_STATES];
+    int state_count = get_sleep_states(states);
+    for (int i = 0; i < state_count; i++) {
+        printf("  C%-3d entries %9d  time %11d ms  energy %11lld mJ\n", states[i].id,
+               sched.sleep_entries[i], sched.sleep_time[i], sched.sleep_energy[i]);
+    }
+    printf("Run time %.3fs", seconds);
+    if (checkpoint_file) {
+        printf(", %d checkpoints (%lld blocks) in %.3fs (%.2f%%)", checkpoints,
+               cp.blocks_written, checkpoint_seconds, 100.0 * checkpoint_seconds / seconds);
+        checkpoint_close(&cp);
+    }
+    printf("\n");
+    free_scheduler(&sched);
+    log_close();
+    return ran > 0 ? 130 : 0;
+}
+
+typedef struct {
+    const char *name;
+    unsigned long long digest;   /* FNV-1a of the schedule's results */
+    long long energy;            /* mJ */
+} GoldenResult;
+
+/* Results of the current schedulers. A change that is meant to alter
+   results must regenerate these with `benchmark check --print`. */
+static const GoldenResult golden_results[] = {
+    {"fcfs/canonical", 0xf4c4ba02b5c135edULL, 30100},
+    {"sjf/canonical", 0x17418d09b8e01402ULL, 30100},
+    {"srtf/canonical", 0xd29a1208718d0df3ULL, 30300},
+    {"round_robin/canonical", 0x6a481058c6c40e41ULL, 30400},
+    {"priority_preemptive/canonical", 0x2e56a24301236415ULL, 30200},
+    {"priority_non_preemptive/canonical", 0xd6ec8d7e5e905565ULL, 30100},
+    {"mlfq/canonical", 0x9aaecf5aefcb4969ULL, 30300},
+    {"fcfs/generated", 0xaae2f9209f1e5ccaULL, 135487000},
+    {"sjf/generated", 0x473e45da41fda36dULL, 135487000},
+    {"srtf/generated", 0x83575cdccd73bc9aULL, 135771600},
+    {"round_robin/generated", 0x0c94e0cc3adcb1d5ULL, 137610300},
+    {"priority_preemptive/generated", 0x586c9fcdca30508bULL, 135963700},
+    {"priority_non_preemptive/generated", 0x389e780eb5cf96a1ULL, 135487000},
+    {"mlfq/generated", 0x204dea043b566a7eULL, 137148400},
+    {"energy_scheduler/case1", 0x84aa7ca8e6ba9ee6ULL, 2850},
+    {"energy_scheduler/case2", 0x9165cd0a7ae4f823ULL, 3600},
+    {"energy_scheduler/case3", 0x87153be90d3d34d5ULL, 4560},
+    {"energy_scheduler/generated", 0xe488a37d6fda5bc8ULL, 134487100},
+    {"multicore/case4_spread", 0xca98a1d986a96739ULL, 17200},
+    {"multicore/case4_pack", 0xf9896795b3676d16ULL, 16600},
+    {"engine/fcfs/timeline", 0x84411d9c322d2128ULL, 135487000},
+    {"engine/fcfs/batch", 0x84411d9c322d2128ULL, 134487100},
+    {"engine/fcfs/dvfs", 0x84411d9c322d2128ULL, 2313176},
+    {"engine/sjf/timeline", 0x14a12e0f9d49078dULL, 135487000},
+    {"engine/sjf/batch", 0x14a12e0f9d49078dULL, 134487100},
+    {"engine/sjf/dvfs", 0x14a12e0f9d49078dULL, 2313176},
+    {"engine/srtf/timeline", 0x093d7e8bb5ffe741ULL, 135771600},
+    {"engine/srtf/batch", 0x093d7e8bb5ffe741ULL, 134487100},
+    {"engine/srtf/dvfs", 0x093d7e8bb5ffe741ULL, 2313176},
+    {"engine/round_robin/timeline", 0x1d98c1c227225a02ULL, 137610300},
+    {"engine/round_robin/batch", 0x1d98c1c227225a02ULL, 134487100},
+    {"engine/round_robin/dvfs", 0x1d98c1c227225a02ULL, 2313176},
+    {"engine/priority_preemptive/timeline", 0x3e848103a14d6c5aULL, 135963700},
+    {"engine/priority_preemptive/batch", 0x3e848103a14d6c5aULL, 134487100},
+    {"engine/priority_preemptive/dvfs", 0x3e848103a14d6c5aULL, 2313176},
+    {"engine/priority_non_preemptive/timeline", 0x423b37928473eb5fULL, 135487000},
+    {"engine/priority_non_preemptive/batch", 0x423b37928473eb5fULL, 134487100},
+    {"engine/priority_non_preemptive/dvfs", 0x423b37928473eb5fULL, 2313176},
+    {"engine/mlfq/timeline", 0xe6bf1b5684fd7decULL, 137148400},
+    {"engine/mlfq/batch", 0xe6bf1b5684fd7decULL, 134487100},
+    {"engine/mlfq/dvfs", 0xe6bf1b5684fd7decULL, 2313176},
+    {"engine/batch/timeline", 0x0702dfc4369532aaULL, 135487000},
+    {"engine/batch/batch", 0x0702dfc4369532aaULL, 134487100},
+    {"engine/batch/dvfs", 0x0702dfc4369532aaULL, 2313176},
+    {"engine/edf/timeline", 0x03c414814d721b0fULL, 135487800},
+    {"engine/edf/batch", 0x03c414814d721b0fULL, 134487100},
+    {"engine/edf/dvfs", 0x03c414814d721b0fULL, 2313176},
+};
+
+typedef struct {
+    const char *name;
+    int arrival_time;
+    int burst_time;
+    int priority;
+} CheckProcess;
+
+/* Small enough to check by hand: overlapping arrivals, bursts longer
+   than one and two quanta, a priority tie, a 1 ms burst and an idle gap. */
+static const CheckProcess canonical_processes[] = {
+    {"P1", 0, 22, 3}, {"P2", 1, 4, 1}, {"P3", 2, 17, 4}, {"P4", 3, 5, 2},
+    {"P5", 5, 1, 1}, {"P6", 60, 6, 2}, {"P7", 62, 3, 2},
+};
+
+typedef struct {
+    int id;
+    int exec_time;
+    int arrival_time;
+    int priority;
+} CheckTask;
+
+/* The test cases of energy_scheduler.c's main(). */
+static const CheckTask energy_case1[] = {{1, 2, 0, 5}, {2, 3, 1, 10}, {3, 1, 2, 3}};
+static const CheckTask energy_case2[] = {{4, 2, 0, 8}, {5, 1, 5, 4}, {6, 3, 10, 6}};
+static const CheckTask energy_case3_early[] = {{13, 3, 0, 4}, {14, 2, 1, 4}};
+static const CheckTask energy_case3_late[] = {{15, 1, 4, 9}, {16, 2, 20, 2}};
+static const CheckTask energy_case4[] = {
+    {7, 4, 0, 5}, {8, 2, 0, 3}, {9, 6, 1, 5}, {10, 3, 2, 7}, {11, 1, 12, 3}, {12, 5, 30, 7}
+};
+
+#define COUNT_OF(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+typedef struct {
+    int print;          /* print golden_results entries instead of comparing */
+    int cases;
+    int properties;
+    int timed;
+    int failures;
+} CheckReport;
+
+static void digest_add(unsigned long long *digest, long long value) {
+    for (int i = 0; i < 8; i++) {
+        *digest = (*digest ^ (unsigned char)(value >> (8 * i))) * 1099511628211ULL;
+    }
+}
+
+static void check_golden(CheckReport *r, const char *name, unsigned long long digest, long long energy) {
+    r->cases++;
+    if (r->print) {
+        printf("    {\"%s\", 0x%016llxULL, %lld},\n", name, digest, energy);
+        return;
+    }
+    const GoldenResult *golden = NULL;
+    for (int i = 0; i < COUNT_OF(golden_results); i++) {
+        if (strcmp(golden_results[i].name, name) == 0) golden = &golden_results[i];
+    }
+    const char *status = !golden ? "no golden result" :
+                         golden->digest != digest || golden->energy != energy ? "CHANGED" : "ok";
+    printf("%-40s | %016llx | %13lld | %s\n", name, digest, energy, status);
+    if (strcmp(status, "ok") != 0) r->failures++;
+}
+
+static void check_property(CheckReport *r, int holds, const char *name, const char *property) {
+    r->properties++;
+    if (holds) return;
+    fprintf(stderr, "FAIL %s: %s\n", name, property);
+    r->failures++;
+}
+
+/* TAT = wait + burst = completion - arrival for every process, and the
+   timeline is ordered, never runs a process before it arrives, and
+   gives each process exactly its burst, ending at its completion. */
+static void check_cpu_properties(CheckReport *r, const char *name, const ProcessList *pl) {
+    int *busy = calloc(pl->count > 0 ? pl->count : 1, sizeof(int));
+    int *last_end = calloc(pl->count > 0 ? pl->count : 1, sizeof(int));
+    if (!busy || !last_end) exit(1);
+    int times_add_up = 1, in_bounds = 1, ordered = 1, conserved = 1;
+    for (int i = 0; i < pl->count; i++) {
+        const Process *p = &pl->processes[i];
+        if (p->turnaround_time != p->waiting_time + p->burst_time ||
+            p->turnaround_time != p->completion_time - p->arrival_time) times_add_up = 0;
+        if (p->waiting_time < 0 || p->start_time < p->arrival_time) in_bounds = 0;
+    }
+    int prev_end = 0;
+    for (int i = 0; i < pl->timeline.count; i++) {
+        const Segment *seg = &pl->timeline.segments[i];
+        if (seg->start < prev_end || seg->end <= seg->start ||
+            seg->start < pl->processes[seg->process].arrival_time) ordered = 0;
+        busy[seg->process] += seg->end - seg->start;
+        last_end[seg->process] = seg->end;
+        prev_end = seg->end;
+    }
+    for (int i = 0; i < pl->count; i++) {
+        if (busy[i] != pl->processes[i].burst_time ||
+            last_end[i] != pl->processes[i].completion_time) conserved = 0;
+    }
+    check_property(r, times_add_up, name, "TAT = wait + burst = completion - arrival");
+    check_property(r, in_bounds, name, "no process starts before it arrives");
+    check_property(r, ordered, name, "timeline is ordered and starts no run early");
+    check_property(r, conserved, name, "each process runs exactly its burst");
+    free(busy);
+    free(last_end);
+}
+
+static void check_cpu(CheckReport *r, const char *dataset, const ProcessList *base) {
+    for (int choice = 1; choice <= 7; choice++) {
+        ProcessList pl = {0};
+        reserve_processes(&pl, base->count);
+        for (int i = 0; i < base->count; i++) {
+            *append_process(&pl) = base->processes[i];
+        }
+        run_algorithm(&pl, choice, BENCH_QUANTUM);
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s/%s", schedulers[choice - 1].name, dataset);
+        unsigned long long digest = DIGEST_INIT;
+        for (int i = 0; i < pl.count; i++) {
+            const Process *p = &pl.processes[i];
+            digest_add(&digest, p->arrival_time);
+            digest_add(&digest, p->burst_time);
+            digest_add(&digest, p->start_time);
+            digest_add(&digest, p->completion_time);
+            digest_add(&digest, p->waiting_time);
+        }
+        for (int i = 0; i < pl.timeline.count; i++) {
+            digest_add(&digest, pl.timeline.segments[i].process);
+            digest_add(&digest, pl.timeline.segments[i].start);
+            digest_add(&digest, pl.timeline.segments[i].end);
+        }
+        check_golden(r, name, digest, timeline_energy(&pl).energy);
+        check_cpu_properties(r, name, &pl);
+        free_process_list(&pl);
+    }
+}
+
+static int add_check_tasks(Scheduler *sched, const CheckTask *tasks, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!add_task(sched, tasks[i].id, tasks[i].exec_time, tasks[i].arrival_time, tasks[i].priority)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Every task ran, the clock is busy time plus time asleep, and the
+   energy is active energy plus what the sleep states charged. */
+static void check_energy(CheckReport *r, const char *name, const Scheduler *sched) {
+    int completed = 1;
+    long long busy = 0, active_energy = 0, asleep = 0, sleep_energy = 0;
+    unsigned long long digest = DIGEST_INIT;
+    for (int i = 0; i < sched->task_count; i++) {
+        const Task *t = &sched->tasks[i];
+        completed &= t->completed;
+        busy += t->exec_time;
+        active_energy += (long long)t->exec_time *
+                         (t->exec_time < 2 ? ENERGY_ACTIVE_BASE / 2 : ENERGY_ACTIVE_BASE);
+    }
+    digest_add(&digest, sched->current_time);
+    for (int i = 0; i < MAX_SLEEP_STATES; i++) {
+        asleep += sched->sleep_time[i];
+        sleep_energy += sched->sleep_energy[i];
+        digest_add(&digest, sched->sleep_entries[i]);
+        digest_add(&digest, sched->sleep_time[i]);
+        digest_add(&digest, sched->sleep_energy[i]);
+    }
+    check_golden(r, name, digest, sched->total_energy);
+    check_property(r, completed, name, "every task completed");
+    check_property(r, sched->current_time == busy + asleep, name, "clock = busy time + time asleep");
+    check_property(r, sched->total_energy == active_energy + sleep_energy, name,
+                   "energy = active energy + sleep state energy");
+}
+
+static void check_multicore(CheckReport *r, const char *name, const Scheduler *sched,
+                            const MultiCoreScheduler *mc) {
+    int completed = 1;
+    long long work = 0, busy = 0;
+    unsigned long long digest = DIGEST_INIT;
+    for (int i = 0; i < sched->task_count; i++) {
+        completed &= sched->tasks[i].completed;
+        work += sched->tasks[i].exec_time;
+    }
+    digest_add(&digest, mc->makespan);
+    for (int c = 0; c < mc->core_count; c++) {
+        const Core *core = &mc->cores[c];
+        busy += core->busy_time;
+        digest_add(&digest, core->energy);
+        digest_add(&digest, core->busy_time);
+        digest_add(&digest, core->idle_time);
+        digest_add(&digest, core->batches_run);
+        digest_add(&digest, core->steals);
+    }
+    check_golden(r, name, digest, mc->total_energy);
+    check_property(r, completed, name, "every task completed");
+    check_property(r, busy == work, name, "core busy time = total exec time");
+}
+
+static void check_energy_scheduler(CheckReport *r, const WorkloadTask *workload) {
+    Scheduler sched;
+    init_scheduler(&sched);
+    if (add_check_tasks(&sched, energy_case1, COUNT_OF(energy_case1))) schedule_tasks(&sched);
+    check_energy(r, "energy_scheduler/case1", &sched);
+    free_scheduler(&sched);
+
+    init_scheduler(&sched);
+    if (add_check_tasks(&sched, energy_case2, COUNT_OF(energy_case2))) schedule_tasks(&sched);
+    check_energy(r, "energy_scheduler/case2", &sched);
+    free_scheduler(&sched);
+
+    init_scheduler(&sched);
+    if (add_check_tasks(&sched, energy_case3_early, COUNT_OF(energy_case3_early))) {
+        scheduler_advance(&sched, 4);
+        if (add_check_tasks(&sched, energy_case3_late, COUNT_OF(energy_case3_late))) {
+            scheduler_step(&sched);
+            scheduler_drain(&sched);
+        }
+    }
+    check_energy(r, "energy_scheduler/case3", &sched);
+    free_scheduler(&sched);
+
+    init_scheduler(&sched);
+    for (int i = 0; i < CHECK_TASKS; i++) {
+        add_task(&sched, workload[i].id, (int)workload[i].duration,
+                 workload[i].arrival_time, workload[i].priority);
+    }
+    schedule_tasks(&sched);
+    check_energy(r, "energy_scheduler/generated", &sched);
+    free_scheduler(&sched);
+
+    for (int policy = PLACE_SPREAD; policy <= PLACE_PACK; policy++) {
+        MultiCoreScheduler mc;
+        init_scheduler(&sched);
+        init_multicore(&mc, 4, (PlacementPolicy)policy);
+        if (add_check_tasks(&sched, energy_case4, COUNT_OF(energy_case4))) {
+            schedule_tasks_multicore(&sched, &mc);
+        }
+        check_multicore(r, policy == PLACE_SPREAD ? "multicore/case4_spread" : "multicore/case4_pack",
+                        &sched, &mc);
+        free_multicore(&mc);
+        free_scheduler(&sched);
+    }
+}
+
+/* Each catalog policy under each energy model. The model only charges
+   the schedule, so the makespan must not depend on it. */
+static void check_engine(CheckReport *r, const ProcessList *base) {
+    static const char *models[ENGINE_MODELS] = {"timeline", "batch", "dvfs"};
+    for (int e = 0; e < COUNT_OF(engine_policies); e++) {
+        const EngineEntry *entry = &engine_policies[e];
+        EngineStats stats[ENGINE_MODELS];
+        for (int m = 0; m < ENGINE_MODELS; m++) {
+            Process *tasks = malloc(base->count * sizeof(Process));
+            if (!tasks) exit(1);
+            memcpy(tasks, base->processes, base->count * sizeof(Process));
+            entry->run[m](tasks, base->count, BENCH_QUANTUM, NULL, &stats[m]);
+            free(tasks);
+
+            char name[64];
+            snprintf(name, sizeof(name), "engine/%s/%s", entry->name, models[m]);
+            unsigned long long digest = DIGEST_INIT;
+            digest_add(&digest, stats[m].makespan);
+            digest_add(&digest, stats[m].context_switches);
+            digest_add(&digest, stats[m].idle_periods);
+            digest_add(&digest, stats[m].deadline_misses);
+            check_golden(r, name, digest, (long long)(stats[m].energy + 0.5));
+            check_property(r, stats[m].makespan == stats[0].makespan, name,
+                           "makespan does not depend on the energy model");
+        }
+    }
+}
+
+/* Best of CHECK_TIMING_RUNS forked runs. Returns measure()'s status,
+   or "CHANGED" if the runs disagree on the checksum. */
+static const char *time_best(const BenchScheduler *bs, int tasks, double budget, BenchSample *best) {
+    for (int run = 0; run < CHECK_TIMING_RUNS; run++) {
+        BenchSample sample;
+        long peak_rss_kb;
+        const char *status = measure(bs, tasks, budget, &sample, &peak_rss_kb);
+        if (strcmp(status, "failed") == 0 || strcmp(status, "timeout") == 0) return status;
+        if (run > 0 && sample.checksum != best->checksum) return "CHANGED";
+        if (run == 0 || sample.seconds < best->seconds) *best = sample;
+    }
+    return "ok";
+}
+
+/* Writes a baseline in the results file format, each scheduler timed at
+   CHECK_TIMED_TASKS by best of CHECK_TIMING_RUNS, which is steadier than
+   the single runs of a plain benchmark. */
+static int save_baseline(const char *baseline_file) {
+    FILE *csv = fopen(baseline_file, "w");
+    if (!csv) {
+        fprintf(stderr, "Error: Could not open %s\n", baseline_file);
+        return 1;
+    }
+    fprintf(csv, "scheduler,tasks,seed,seconds,ns_per_task,peak_rss_kb,checksum,status\n");
+    for (int s = 0; s < COUNT_OF(schedulers); s++) {
+        BenchSample best = {0, 0};
+        const char *status = time_best(&schedulers[s], CHECK_TIMED_TASKS, DEFAULT_BUDGET_SECONDS, &best);
+        printf("%-31s | %8d | %9.4f | %s\n", schedulers[s].name, CHECK_TIMED_TASKS, best.seconds, status);
+        fprintf(csv, "%s,%d,%d,%.6f,%.1f,0,%lld,%s\n", schedulers[s].name, CHECK_TIMED_TASKS,
+                BENCH_SEED, best.seconds, best.seconds * 1e9 / CHECK_TIMED_TASKS, best.checksum, status);
+    }
+    fclose(csv);
+    printf("Baseline written to %s\n", baseline_file);
+    return 0;
+}
+
+/* Re-times each row of a results file that finished within budget,
+   skipping sizes under CHECK_TIMED_TASKS. A row fails if its checksum
+   changed or its best run is more than `slack` percent slower. */
+static void check_timing(CheckReport *r, const char *baseline_file, double slack) {
+    FILE *csv = fopen(baseline_file, "r");
+    if (!csv) {
+        printf("\nNo baseline %s; timing budgets skipped (write one with check --save)\n", baseline_file);
+        return;
+    }
+    printf("\nTiming Budgets (baseline %s, %.0f%% slack, best of %d)\n",
+           baseline_file, slack, CHECK_TIMING_RUNS);
+    printf("Scheduler                       | Tasks    | Base (s)  | Best (s)  | Change   | Status\n");
+    printf("--------------------------------|----------|-----------|-----------|----------|------------\n");
+
+    char name[64], status[32];
+    long long tasks, checksum;
+    int seed;
+    double seconds, ns_per_task;
+    long rss_kb;
+    if (fscanf(csv, "%*[^\n]\n") != 0) {
+        fclose(csv);
+        return;
+    }
+    while (fscanf(csv, "%63[^,],%lld,%d,%lf,%lf,%ld,%lld,%31s\n",
+                  name, &tasks, &seed, &seconds, &ns_per_task, &rss_kb, &checksum, status) == 8) {
+        if (strcmp(status, "ok") != 0 || seed != BENCH_SEED || tasks < CHECK_TIMED_TASKS) continue;
+        const BenchScheduler *bs = NULL;
+        for (int s = 0; s < COUNT_OF(schedulers); s++) {
+            if (strcmp(schedulers[s].name, name) == 0) bs = &schedulers[s];
+        }
+        if (!bs) continue;
+
+        double limit = seconds * (1 + slack / 100);
+        BenchSample best = {0, 0};
+        const char *result = time_best(bs, (int)tasks, limit, &best);
+        if (strcmp(result, "ok") == 0 && best.checksum != checksum) result = "CHANGED";
+        if (strcmp(result, "ok") == 0 && best.seconds > limit) result = "SLOWER";
+        printf("%-31s | %8lld | %9.4f | %9.4f | %+7.1f%% | %s\n",
+               name, tasks, seconds, best.seconds, 100 * (best.seconds / seconds - 1), result);
+        r->timed++;
+        if (strcmp(result, "ok") != 0) r->failures++;
+    }
+    fclose(csv);
+}
+
+/* Regression check: golden results for every scheduler on a canonical
+   and a generated dataset, property checks on each schedule, and
+   timing budgets against a saved benchmark run. Returns 1 if anything
+   failed. */
+int check_benchmark(int print, const char *baseline_file, double slack) {
+    CheckReport report = {print, 0, 0, 0, 0};
+    int seed = BENCH_SEED;
+    WorkloadTask *workload = generate_workload(CHECK_TASKS, &seed);
+    if (!workload) return 1;
+    ProcessList canonical = {0}, generated = {0};
+    for (int i = 0; i < COUNT_OF(canonical_processes); i++) {
+        const CheckProcess *c = &canonical_processes[i];
+        Process *p = append_process(&canonical);
+        snprintf(p->name, sizeof(p->name), "%s", c->name);
+        p->arrival_time = c->arrival_time;
+        p->burst_time = c->burst_time;
+        p->priority = c->priority;
+        p->remaining_time = c->burst_time;
+    }
+    workload_processes(&generated, workload, CHECK_TASKS);
+    log_open(NULL, LOG_QUIET, 0);
+
+    if (!print) {
+        printf("Golden Results (generated: %d tasks, seed %d, quantum %d)\n",
+               CHECK_TASKS, BENCH_SEED, BENCH_QUANTUM);
+        printf("Case                                     | Digest           | Energy (mJ)   | Status\n");
+        printf("-----------------------------------------|------------------|---------------|------------\n");
+    }
+    check_cpu(&report, "canonical", &canonical);
+    check_cpu(&report, "generated", &generated);
+    check_energy_scheduler(&report, workload);
+    sort_by_arrival(&generated);
+    check_engine(&report, &generated);
+    log_close();
+    free_process_list(&canonical);
+    free_process_list(&generated);
+    free_workload(workload);
+    if (print) return report.failures > 0;
+
+    check_timing(&report, baseline_file, slack);
+    printf("\n%d golden results, %d properties, %d timed runs: %s (%d failures)\n",
+           report.cases, report.properties, report.timed,
+           report.failures ? "FAILED" : "passed", report.failures);
+    return report.failures > 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "engine") == 0) {
+        int num_tasks = argc > 2 ? atoi(argv[2]) : DEFAULT_ENGINE_TASKS;
+        if (num_tasks < 1) {
+            fprintf(stderr, "Usage: %s engine [tasks]\n", argv[0]);
+            return 1;
+        }
+        return engine_benchmark(num_tasks);
+    }
+    if (argc > 1 && strcmp(argv[1], "check") == 0) {
+        if (argc > 2 && strcmp(argv[2], "--print") == 0) {
+            return check_benchmark(1, NULL, 0);
+        }
+        if (argc > 2 && strcmp(argv[2], "--save") == 0) {
+            return save_baseline(argc > 3 ? argv[3] : DEFAULT_BASELINE_FILE);
+        }
+        double slack = argc > 3 ? atof(argv[3]) : DEFAULT_CHECK_SLACK;
+        if (slack < 0) {
+            fprintf(stderr, "Usage: %s check [--print | --save [baseline.csv] | "
+                    "[baseline.csv [slack_percent]]]\n", argv[0]);
+            return 1;
+        }
+        return check_benchmark(0, argc > 2 ? argv[2] : DEFAULT_BASELINE_FILE, slack);
+    }
+    if (argc > 1 && strcmp(argv[1], "replay") == 0) {
+        int num_tasks = argc > 2 ? atoi(argv[2]) : DEFAULT_REPLAY_TASKS;
+        double interval = argc > 4 ? atof(argv[4]) : DEFAULT_CHECKPOINT_SECONDS;
+        if (num_tasks < 1 || interval < 0) {
+            fprintf(stderr, "Usage: %s replay [tasks] [checkpoint_file] [interval_seconds]\n", argv[0]);
+            return 1;
+        }
+        return replay_benchmark(num_tasks, argc > 3 ? argv[3] : NULL, interval, 0);
+    }
+    if (argc > 1 && strcmp(argv[1], "resume") == 0) {
+        double interval = argc > 3 ? atof(argv[3]) : DEFAULT_CHECKPOINT_SECONDS;
+        if (argc < 3 || interval < 0) {
+            fprintf(stderr, "Usage: %s resume checkpoint_file [interval_seconds]\n", argv[0]);
+            return 1;
+        }
+        return replay_benchmark(0, argv[2], interval, 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "kernels") == 0) {
+        int num_tasks = argc > 2 ? atoi(argv[2]) : DEFAULT_KERNEL_TASKS;
+        if (num_tasks < 1) {
+            fprintf(stderr, "Usage: %s kernels [tasks]\n", argv[0]);
+            return 1;
+        }
+        return kernel_benchmark(num_tasks, DEFAULT_BUDGET_SECONDS);
+    }
+    if (argc > 1 && strcmp(argv[1], "submit") == 0) {
+        int max_producers = argc > 2 ? atoi(argv[2]) : DEFAULT_MAX_PRODUCERS;
+        int num_tasks = argc > 3 ? atoi(argv[3]) : DEFAULT_SUBMIT_TASKS;
+        if (max_producers < 1 || num_tasks < 1) {
+            fprintf(stderr, "Usage: %s submit [max_producers] [tasks]\n", argv[0]);
+            return 1;
+        }
+        return submit_benchmark(max_producers, num_tasks);
+    }
+
+    int max_tasks = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_TASKS;
+    double budget = argc > 2 ? atof(argv[2]) : DEFAULT_BUDGET_SECONDS;
+    const char *results_file = argc > 3 ? argv[3] : DEFAULT_RESULTS_FILE;
+    int scheduler_count = sizeof(schedulers) / sizeof(schedulers[0]);
+
+    FILE *csv = fopen(results_file, "w");
+    if (!csv) {
+        fprintf(stderr, "Error: Could not open %s\n", results_file);
+        return 1;
+    }
+    fprintf(csv, "scheduler,tasks,seed,seconds,ns_per_task,peak_rss_kb,checksum,status\n");
+
+    printf("Scheduler Benchmark (seed %d, budget %.1fs per run)\n", BENCH_SEED, budget);
+    printf("Scheduler                       | Tasks    | Time (s)  | ns/task  | Peak RSS (KB) | Status\n");
+    printf("--------------------------------|----------|-----------|----------|---------------|------------\n");
+
+    for (int s = 0; s < scheduler_count; s++) {
+        const BenchScheduler *bs = &schedulers[s];
+        int skip = 0;
+        for (long long n = 1000; n <= max_tasks; n *= 10) {
+            BenchSample sample = {0, 0};
+            long peak_rss_kb = 0;
+            const char *status = "skipped";
+            if (!skip) {
+                status = measure(bs, (int)n, budget, &sample, &peak_rss_kb);
+                skip = strcmp(status, "ok") != 0;
+            }
+            double ns_per_task = sample.seconds * 1e9 / n;
+
+            printf("%-31s | %8lld | %9.4f | %8.1f | %13ld | %s\n",
+                   bs->name, n, sample.seconds, ns_per_task, peak_rss_kb, status);
+            fprintf(csv, "%s,%lld,%d,%.6f,%.1f,%ld,%lld,%s\n",
+                    bs->name, n, BENCH_SEED, sample.seconds, ns_per_task,
+                    peak_rss_kb, sample.checksum, status);
+            fflush(csv);
+        }
+    }
+
+    fclose(csv);
+    printf("\nResults written to %s\n", results_file);
+    return 0;
+}
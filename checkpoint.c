@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "checkpoint.h"
+
+static size_t block_offset(int block, int slot) {
+    return CHECKPOINT_HEADER_BYTES + ((size_t)block * 2 + slot) * CHECKPOINT_BLOCK_BYTES;
+}
+
+static CheckpointHeader *slot_header(const Checkpoint *cp, int slot) {
+    return (CheckpointHeader *)(cp->base + (size_t)slot * CHECKPOINT_SLOT_STRIDE);
+}
+
+static uint64_t header_checksum(const CheckpointHeader *h) {
+    CheckpointHeader copy = *h;
+    copy.checksum = 0;
+    const unsigned char *bytes = (const unsigned char *)&copy;
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < sizeof(copy); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* Grows the file and its mapping to hold at least `blocks` task blocks,
+   doubling so a growing task table remaps only a few times. */
+static int reserve_blocks(Checkpoint *cp, int blocks) {
+    if (cp->base) {
+        if (blocks <= cp->blocks) return 1;
+        if (blocks < cp->blocks * 2) blocks = cp->blocks * 2;
+    }
+    size_t size = block_offset(blocks, 0);
+    if (cp->base) munmap(cp->base, cp->size);
+    cp->base = NULL;
+    if (ftruncate(cp->fd, size) != 0) {
+        fprintf(stderr, "Error: Could not grow checkpoint file\n");
+        return 0;
+    }
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, cp->fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: Could not map checkpoint file\n");
+        return 0;
+    }
+    cp->base = base;
+    cp->size = size;
+    cp->blocks = blocks;
+    return 1;
+}
+
+/* The blocks both slots are missing: all of them, as the next checkpoint
+   goes to a slot holding nothing of this run. */
+static int start_tracking(Checkpoint *cp, Scheduler *sched) {
+    if (!scheduler_track_changes(sched)) return 0;
+    cp->pending_words = CHANGE_WORDS(sched->capacity);
+    cp->pending = malloc(cp->pending_words * sizeof(uint64_t));
+    if (!cp->pending) {
+        fprintf(stderr, "Error: Could not allocate change tracking\n");
+        return 0;
+    }
+    memset(cp->pending, 0xff, cp->pending_words * sizeof(uint64_t));
+    return 1;
+}
+
+static int open_file(Checkpoint *cp, const char *filename, int flags) {
+    memset(cp, 0, sizeof(Checkpoint));
+    cp->fd = open(filename, flags, 0644);
+    if (cp->fd < 0) {
+        fprintf(stderr, "Error: Could not open %s\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+/* Starts a new checkpoint file for `sched`, replacing any old one. */
+int checkpoint_create(Checkpoint *cp, const char *filename, Scheduler *sched) {
+    if (!open_file(cp, filename, O_RDWR | O_CREAT | O_TRUNC)) return 0;
+    int blocks = (sched->task_count + CHANGE_BLOCK_TASKS - 1) / CHANGE_BLOCK_TASKS;
+    if (!reserve_blocks(cp, blocks > 0 ? blocks : 1) || !start_tracking(cp, sched)) {
+        checkpoint_close(cp);
+        return 0;
+    }
+    return 1;
+}
+
+static const char *check_header(const CheckpointHeader *h, size_t file_size) {
+    if (memcmp(h->magic, CHECKPOINT_MAGIC, 4) != 0 || h->generation == 0) return "empty";
+    if (h->version != CHECKPOINT_VERSION) return "unsupported version";
+    if (h->checksum != header_checksum(h)) return "torn header";
+    if (h->task_count < 0 || h->submitted < 0 || h->submitted > h->task_count ||
+        h->sleep_state_count < 1 || h->sleep_state_count > MAX_SLEEP_STATES ||
+        h->sleep_state < 0 || h->sleep_state >= h->sleep_state_count) return "bad counters";
+    int blocks = (h->task_count + CHANGE_BLOCK_TASKS - 1) / CHANGE_BLOCK_TASKS;
+    if (block_offset(blocks, 0) > file_size) return "truncated task table";
+    return NULL;
+}
+
+/* Restores `sched` (which must not be initialised) from the newest
+   complete slot of the file and keeps the file open, so the resumed run
+   carries on checkpointing into it. */
+int checkpoint_resume(Checkpoint *cp, const char *filename, Scheduler *sched) {
+    if (!open_file(cp, filename, O_RDWR)) return 0;
+    struct stat st;
+    if (fstat(cp->fd, &st) != 0 || (size_t)st.st_size < CHECKPOINT_HEADER_BYTES) {
+        fprintf(stderr, "Error: %s is not a checkpoint file\n", filename);
+        checkpoint_close(cp);
+        return 0;
+    }
+    cp->blocks = (st.st_size - CHECKPOINT_HEADER_BYTES) / (2 * CHECKPOINT_BLOCK_BYTES);
+    if (!reserve_blocks(cp, cp->blocks)) {
+        checkpoint_close(cp);
+        return 0;
+    }
+
+    int slot = -1;
+    const char *problem = NULL;
+    for (int s = 0; s < 2; s++) {
+        const char *p = check_header(slot_header(cp, s), cp->size);
+        if (p) {
+            if (!problem || strcmp(problem, "empty") == 0) problem = p;
+        } else if (slot == -1 || slot_header(cp, s)->generation > slot_header(cp, slot)->generation) {
+            slot = s;
+        }
+    }
+    if (slot == -1) {
+        fprintf(stderr, "Error: %s holds no complete checkpoint (%s)\n", filename, problem);
+        checkpoint_close(cp);
+        return 0;
+    }
+
+    const CheckpointHeader *h = slot_header(cp, slot);
+    init_scheduler(sched);
+    int capacity = 64;
+    while (capacity < h->task_count) capacity *= 2;
+    sched->tasks = malloc(capacity * sizeof(Task));
+    if (!sched->tasks || !set_sleep_states(h->sleep_states, h->sleep_state_count)) {
+        fprintf(stderr, "Error: Could not restore scheduler from %s\n", filename);
+        free_scheduler(sched);
+        checkpoint_close(cp);
+        return 0;
+    }
+    sched->capacity = capacity;
+    for (int first = 0; first < h->task_count; first += CHANGE_BLOCK_TASKS) {
+        int count = h->task_count - first < CHANGE_BLOCK_TASKS ? h->task_count - first : CHANGE_BLOCK_TASKS;
+        memcpy(&sched->tasks[first], cp->base + block_offset(first / CHANGE_BLOCK_TASKS, slot),
+               count * sizeof(Task));
+    }
+    sched->task_count = h->task_count;
+    sched->submitted = h->submitted;
+    sched->current_time = h->current_time;
+    sched->total_energy = h->total_energy;
+    sched->active = h->active;
+    sched->sleep_state = h->sleep_state;
+    memcpy(sched->sleep_entries, h->sleep_entries, sizeof(sched->sleep_entries));
+    memcpy(sched->sleep_time, h->sleep_time, sizeof(sched->sleep_time));
+    for (int i = 0; i < MAX_SLEEP_STATES; i++) {
+        sched->sleep_energy[i] = h->sleep_energy[i];
+    }
+    scheduler_rebuild_queues(sched, h->wheel_now);
+    cp->generation = h->generation;
+
+    if (!start_tracking(cp, sched)) {
+        free_scheduler(sched);
+        checkpoint_close(cp);
+        return 0;
+    }
+    return 1;
+}
+
+/* After a failed checkpoint neither slot's view of the tasks can be
+   trusted to be current, so the next two rewrite every block. */
+static int save_failed(Checkpoint *cp, Scheduler *sched) {
+    memset(sched->changed, 0xff, CHANGE_WORDS(sched->capacity) * sizeof(uint64_t));
+    memset(cp->pending, 0xff, cp->pending_words * sizeof(uint64_t));
+    return 0;
+}
+
+/* Writes the scheduler's state to the older slot. Only call between
+   scheduler steps. A block is copied if it changed since the last
+   checkpoint or the one before, which this slot missed. Returns 1 once
+   the slot is durable, 0 on failure (the other slot stays valid). */
+int checkpoint_save(Checkpoint *cp, Scheduler *sched) {
+    int blocks = (sched->task_count + CHANGE_BLOCK_TASKS - 1) / CHANGE_BLOCK_TASKS;
+    if (!reserve_blocks(cp, blocks)) return save_failed(cp, sched);
+    int words = CHANGE_WORDS(sched->capacity);
+    if (cp->pending_words < words) {
+        uint64_t *pending = realloc(cp->pending, words * sizeof(uint64_t));
+        if (!pending) {
+            fprintf(stderr, "Error: Could not grow change tracking\n");
+            return save_failed(cp, sched);
+        }
+        memset(pending + cp->pending_words, 0, (words - cp->pending_words) * sizeof(uint64_t));
+        cp->pending = pending;
+        cp->pending_words = words;
+    }
+
+    uint64_t generation = cp->generation + 1;
+    int slot = generation % 2;
+    size_t low = cp->size, high = 0;
+    for (int w = 0; w < words; w++) {
+        uint64_t bits = sched->changed[w] | cp->pending[w];
+        cp->pending[w] = sched->changed[w];
+        sched->changed[w] = 0;
+        while (bits) {
+            int block = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (block >= blocks) break;
+            int first = block * CHANGE_BLOCK_TASKS;
+            int count = sched->task_count - first < CHANGE_BLOCK_TASKS ? sched->task_count - first : CHANGE_BLOCK_TASKS;
+            size_t offset = block_offset(block, slot);
+            memcpy(cp->base + offset, &sched->tasks[first], count * sizeof(Task));
+            if (offset < low) low = offset;
+            if (offset + CHECKPOINT_BLOCK_BYTES > high) high = offset + CHECKPOINT_BLOCK_BYTES;
+            cp->blocks_written++;
+        }
+    }
+
+    /* The blocks must reach the file before the header that vouches
+       for them. */
+    if (high > low) {
+        size_t page = sysconf(_SC_PAGESIZE);
+        low -= low % page;
+        if (msync(cp->base + low, high - low, MS_SYNC) != 0) {
+            fprintf(stderr, "Error: Could not sync checkpoint\n");
+            return save_failed(cp, sched);
+        }
+    }
+
+    CheckpointHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CHECKPOINT_MAGIC, 4);
+    h.version = CHECKPOINT_VERSION;
+    h.generation = generation;
+    h.task_count = sched->task_count;
+    h.submitted = sched->submitted;
+    h.current_time = sched->current_time;
+    h.wheel_now = sched->future.now;
+    h.total_energy = sched->total_energy;
+    h.active = sched->active;
+    h.sleep_state = sched->sleep_state;
+    h.sleep_state_count = get_sleep_states(h.sleep_states);
+    memcpy(h.sleep_entries, sched->sleep_entries, sizeof(h.sleep_entries));
+    memcpy(h.sleep_time, sched->sleep_time, sizeof(h.sleep_time));
+    for (int i = 0; i < MAX_SLEEP_STATES; i++) {
+        h.sleep_energy[i] = sched->sleep_energy[i];
+    }
+    h.checksum = header_checksum(&h);
+    memcpy(slot_header(cp, slot), &h, sizeof(h));
+    if (msync(cp->base, CHECKPOINT_HEADER_BYTES, MS_SYNC) != 0) {
+        fprintf(stderr, "Error: Could not sync checkpoint\n");
+        return save_failed(cp, sched);
+    }
+    cp->generation = generation;
+    return 1;
+}
+
+void checkpoint_close(Checkpoint *cp) {
+    if (cp->base) munmap(cp->base, cp->size);
+    if (cp->fd >= 0) close(cp->fd);
+    free(cp->pending);
+    memset(cp, 0, sizeof(Checkpoint));
+    cp->fd = -1;
+}
@@ -0,0 +1,68 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "energy_scheduler.h"
+
+/*
+ * Checkpoint file for a single-core Scheduler, kept memory-mapped.
+ *
+ * The file holds two slots, written alternately, so a run killed in the
+ * middle of a checkpoint still leaves the previous one intact. Each
+ * slot is a header (clock, energy counters, sleep statistics and the
+ * sleep state table) plus a copy of the task table, stored in blocks of
+ * CHANGE_BLOCK_TASKS tasks with the two slots' copies of a block next
+ * to each other. The scheduler records which blocks changed, so a
+ * checkpoint copies only those, then syncs the blocks and finally its
+ * header, whose checksum marks the slot complete.
+ *
+ * The ready heap and arrival wheel are not stored: a checkpoint is only
+ * taken between scheduler steps, where both follow from the task table
+ * and the wheel's time (see scheduler_rebuild_queues()). A resumed run
+ * therefore ends bit-identical to one that was never interrupted.
+ * Integers are stored in host byte order.
+ */
+
+#define CHECKPOINT_MAGIC "ESCK"
+#define CHECKPOINT_VERSION 2               /* 1 had 32-bit energy totals */
+#define CHECKPOINT_HEADER_BYTES 4096       /* both slot headers */
+#define CHECKPOINT_SLOT_STRIDE 2048        /* offset of slot 1's header */
+#define CHECKPOINT_BLOCK_BYTES (CHANGE_BLOCK_TASKS * sizeof(Task))
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t generation;    /* 0 while the slot has never been written */
+    uint64_t checksum;      /* FNV-1a of the header with this field zero */
+    int64_t total_energy;
+    int64_t sleep_energy[MAX_SLEEP_STATES];
+    int32_t task_count;
+    int32_t submitted;
+    int32_t current_time;
+    int32_t wheel_now;
+    int32_t active;
+    int32_t sleep_state;
+    int32_t sleep_state_count;
+    int32_t sleep_entries[MAX_SLEEP_STATES];
+    int32_t sleep_time[MAX_SLEEP_STATES];
+    SleepState sleep_states[MAX_SLEEP_STATES];
+} CheckpointHeader;
+
+typedef struct {
+    int fd;
+    unsigned char *base;
+    size_t size;
+    int blocks;             /* task blocks the file has room for */
+    uint64_t *pending;      /* blocks the slot written next has not seen */
+    int pending_words;
+    uint64_t generation;    /* of the newest complete slot */
+    long long blocks_written;
+} Checkpoint;
+
+int checkpoint_create(Checkpoint *cp, const char *filename, Scheduler *sched);
+int checkpoint_resume(Checkpoint *cp, const char *filename, Scheduler *sched);
+int checkpoint_save(Checkpoint *cp, Scheduler *sched);
+void checkpoint_close(Checkpoint *cp);
+
+#endif
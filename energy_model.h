@@ -0,0 +1,25 @@
+#ifndef ENERGY_MODEL_H
+#define ENERGY_MODEL_H
+
+/* Energy model shared by energy_scheduler.c and the CPU.c policies.
+   Rates are mJ per ms; the penalty is charged once per state change. */
+#define ENERGY_ACTIVE_BASE 500    
+#define ENERGY_IDLE 50           
+#define STATE_TRANSITION_PENALTY 100  
+
+#define MAX_SLEEP_STATES 8
+
+/* An idle state of the single-core scheduler. Entering and leaving cost
+   a fixed amount of energy on top of the residency power, which is paid
+   for the whole gap. A state can only be used for a gap at least as long
+   as its entry plus exit latency. */
+typedef struct {
+    int id;              /* reported as C<id> */
+    int entry_latency;   /* ms */
+    int exit_latency;    /* ms */
+    int entry_energy;    /* mJ */
+    int exit_energy;     /* mJ */
+    int power;           /* mJ per ms while idle in this state */
+} SleepState;
+
+#endif
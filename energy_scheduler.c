@@ -1,21 +1,95 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include "energy_scheduler.h"
+#include "event_log.h"
+#include "energy_model.h"
 
-#define ENERGY_ACTIVE_BASE 500    
-#define ENERGY_IDLE 50           
-#define STATE_TRANSITION_PENALTY 100  
+#define PACK_BACKLOG_LIMIT 20
 #define LOG_FILE "scheduler_log.txt"
-FILE *log_file;
 
-void init_scheduler(Scheduler *sched) {
-    sched->task_count = 0;
-    sched->total_energy = 0;
-    sched->current_time = 0;
-    for (int i = 0; i < MAX_TASKS; i++) {
-        sched->tasks[i].completed = 1;  
+/* C1 is the flat model: one penalty in, one out and ENERGY_IDLE per ms.
+   The deeper states only pay off on longer gaps. */
+static SleepState sleep_states[MAX_SLEEP_STATES] = {
+    {1, 0, 0, STATE_TRANSITION_PENALTY, STATE_TRANSITION_PENALTY, ENERGY_IDLE},
+    {3, 1, 1, 250, 250, 15},
+    {6, 2, 3, 600, 700, 3}
+};
+static int sleep_state_count = 3;
+
+/* Replaces the sleep state table. States must go from shallowest to
+   deepest, each drawing less power than the one before. Returns 1 on
+   success, 0 (keeping the old table) otherwise. */
+int set_sleep_states(const SleepState *states, int count) {
+    if (count < 1 || count > MAX_SLEEP_STATES) {
+        fprintf(stderr, "Error: Sleep state table needs 1 to %d states\n", MAX_SLEEP_STATES);
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        const SleepState *s = &states[i];
+        if (s->entry_latency < 0 || s->exit_latency < 0 || s->entry_energy < 0 ||
+            s->exit_energy < 0 || s->power < 0 || (i > 0 && s->power >= states[i - 1].power)) {
+            fprintf(stderr, "Error: Invalid sleep state C%d\n", s->id);
+            return 0;
+        }
+    }
+    memcpy(sleep_states, states, count * sizeof(SleepState));
+    sleep_state_count = count;
+    return 1;
+}
+
+/* Copies the current table into `states`; returns its length. */
+int get_sleep_states(SleepState *states) {
+    memcpy(states, sleep_states, sleep_state_count * sizeof(SleepState));
+    return sleep_state_count;
+}
+
+static long long sleep_cost(const SleepState *s, int gap) {
+    return (long long)s->entry_energy + s->exit_energy + (long long)gap * s->power;
+}
+
+/* Cheapest state whose latencies fit in the gap. The shallowest state
+   is the fallback, and wins ties. */
+static int choose_sleep_state(int gap) {
+    int best = 0;
+    for (int i = 1; i < sleep_state_count; i++) {
+        const SleepState *s = &sleep_states[i];
+        if (gap < s->entry_latency + s->exit_latency) continue;
+        if (sleep_cost(s, gap) < sleep_cost(&sleep_states[best], gap)) best = i;
+    }
+    return best;
+}
+
+/* Shortest gap for which choose_sleep_state() picks `state`, or -1 if a
+   shallower state is always at least as cheap. */
+int sleep_break_even(int state) {
+    const SleepState *s = &sleep_states[state];
+    int gap = s->entry_latency + s->exit_latency;
+    for (int i = 0; i < state; i++) {
+        const SleepState *shallow = &sleep_states[i];
+        int extra = s->entry_energy + s->exit_energy - shallow->entry_energy - shallow->exit_energy;
+        if (extra < 0) continue;
+        int saved = shallow->power - s->power;
+        if (extra / saved + 1 > gap) gap = extra / saved + 1;
     }
+    return choose_sleep_state(gap) == state ? gap : -1;
+}
+
+/* The CPU starts asleep in the shallowest state; that counts as an entry,
+   so the exit energy of the first wake shows up against one. */
+void init_scheduler(Scheduler *sched) {
+    memset(sched, 0, sizeof(Scheduler));
+    sched->sleep_entries[0] = 1;
+    wheel_init(&sched->future);
+}
+
+void free_scheduler(Scheduler *sched) {
+    free(sched->tasks);
+    free(sched->changed);
+    wheel_free(&sched->future);
+    free(sched->ready);
+    init_scheduler(sched);
 }
 
 
@@ -31,173 +105,578 @@ int calculate_batch_energy(int exec_time, int active, int *new_active) {
     return energy;
 }
 
+static void mark_changed(Scheduler *sched, int idx) {
+    int block = idx / CHANGE_BLOCK_TASKS;
+    sched->changed[block / 64] |= 1ULL << (block % 64);
+}
+
 int add_task(Scheduler *sched, int id, int exec_time, int arrival_time, int priority) {
-    if (sched->task_count >= MAX_TASKS) {
-        fprintf(stderr, "Error: Task queue full\n");
-        fprintf(log_file, "Error: Task queue full\n");
-        return 0;
-    }
     if (exec_time <= 0 || arrival_time < 0 || priority < 0) {
+        log_flush();
         fprintf(stderr, "Error: Invalid task parameters (id=%d, exec_time=%d, arrival=%d, priority=%d)\n",
                 id, exec_time, arrival_time, priority);
-        fprintf(log_file, "Error: Invalid task parameters (id=%d, exec_time=%d, arrival=%d, priority=%d)\n",
-                id, exec_time, arrival_time, priority);
+        LOG_EVENT(LOG_QUIET, EV_ERROR_INVALID_TASK, id, exec_time, arrival_time, priority);
         return 0;
     }
+    if (sched->task_count == sched->capacity) {
+        int capacity = sched->capacity ? sched->capacity * 2 : 64;
+        Task *grown = realloc(sched->tasks, capacity * sizeof(Task));
+        if (grown) sched->tasks = grown;
+        if (grown && sched->changed) {
+            int words = CHANGE_WORDS(capacity), old_words = CHANGE_WORDS(sched->capacity);
+            uint64_t *changed = realloc(sched->changed, words * sizeof(uint64_t));
+            if (changed) {
+                memset(changed + old_words, 0, (words - old_words) * sizeof(uint64_t));
+                sched->changed = changed;
+            } else {
+                grown = NULL;
+            }
+        }
+        if (!grown) {
+            log_flush();
+            fprintf(stderr, "Error: Task queue full\n");
+            LOG_EVENT(LOG_QUIET, EV_ERROR_QUEUE_FULL, 0);
+            return 0;
+        }
+        sched->capacity = capacity;
+    }
+    if (sched->changed) mark_changed(sched, sched->task_count);
     Task *t = &sched->tasks[sched->task_count++];
     t->task_id = id;
     t->exec_time = exec_time;
     t->arrival_time = arrival_time;
     t->priority = priority;
     t->completed = 0;
-    printf("Added Task %d: Exec Time = %dms, Arrival = %dms, Priority = %d\n", 
-           id, exec_time, arrival_time, priority);
-    fprintf(log_file, "Added Task %d: Exec Time = %dms, Arrival = %dms, Priority = %d\n", 
-            id, exec_time, arrival_time, priority);
+    LOG_EVENT(LOG_EVENTS, EV_TASK_ADDED, id, exec_time, arrival_time, priority);
     return 1;
 }
 
 
-int has_pending_tasks(Scheduler *sched) {
+typedef struct {
+    int arrival_time;
+    int idx;
+} ArrivalRef;
+
+int compare_arrival(const void *a, const void *b) {
+    const ArrivalRef *x = a, *y = b;
+    if (x->arrival_time != y->arrival_time) return x->arrival_time < y->arrival_time ? -1 : 1;
+    return x->idx - y->idx;
+}
+
+/* Highest priority first; inside a priority, shortest exec time first. */
+int compare_ready(const void *a, const void *b) {
+    const ReadyRef *x = a, *y = b;
+    if (x->priority != y->priority) return x->priority > y->priority ? -1 : 1;
+    if (x->exec_time != y->exec_time) return x->exec_time < y->exec_time ? -1 : 1;
+    return x->idx - y->idx;
+}
+
+void ready_push(Scheduler *sched, int idx) {
+    Task *t = &sched->tasks[idx];
+    ReadyRef ref = {t->priority, t->exec_time, idx};
+    int i = sched->ready_count++;
+    while (i > 0 && compare_ready(&ref, &sched->ready[(i - 1) / 2]) < 0) {
+        sched->ready[i] = sched->ready[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    sched->ready[i] = ref;
+}
+
+int ready_pop(Scheduler *sched) {
+    int top = sched->ready[0].idx;
+    ReadyRef last = sched->ready[--sched->ready_count];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= sched->ready_count) break;
+        if (child + 1 < sched->ready_count &&
+            compare_ready(&sched->ready[child + 1], &sched->ready[child]) < 0) child++;
+        if (compare_ready(&sched->ready[child], &last) >= 0) break;
+        sched->ready[i] = sched->ready[child];
+        i = child;
+    }
+    sched->ready[i] = last;
+    return top;
+}
+
+/* Files tasks added since the last call on the arrival wheel, then
+   releases every arrival that is due into the ready heap. Tasks already
+   completed elsewhere (e.g. by the multi-core scheduler) are skipped. */
+static void reserve_queues(Scheduler *sched) {
+    if (sched->queue_capacity < sched->task_count) {
+        int capacity = sched->capacity;
+        ReadyRef *ready = realloc(sched->ready, capacity * sizeof(ReadyRef));
+        if (ready) sched->ready = ready;
+        if (!ready || !wheel_reserve(&sched->future, capacity)) {
+            fprintf(stderr, "Error: Could not grow scheduler queues\n");
+            exit(1);
+        }
+        sched->queue_capacity = capacity;
+    }
+}
+
+void admit_tasks(Scheduler *sched) {
+    reserve_queues(sched);
+    for (; sched->submitted < sched->task_count; sched->submitted++) {
+        Task *t = &sched->tasks[sched->submitted];
+        if (!t->completed) {
+            wheel_insert(&sched->future, sched->submitted, t->arrival_time);
+        }
+    }
+    int idx = wheel_advance(&sched->future, sched->current_time);
+    while (idx != -1) {
+        int next = sched->future.next[idx];
+        ready_push(sched, idx);
+        idx = next;
+    }
+}
+
+void idle_until(Scheduler *sched, int time) {
+    if (time <= sched->current_time) return;
+    int idle_duration = time - sched->current_time;
+    if (sched->active) {
+        /* The gap runs to the next known arrival, even when the caller
+           only idles part of the way there. */
+        int next_arrival = wheel_next_time(&sched->future);
+        int gap = next_arrival > time ? next_arrival - sched->current_time : idle_duration;
+        int state = choose_sleep_state(gap);
+        int entry_energy = sleep_states[state].entry_energy;
+        sched->total_energy += entry_energy;
+        sched->active = 0;
+        sched->sleep_state = state;
+        sched->sleep_entries[state]++;
+        sched->sleep_energy[state] += entry_energy;
+        LOG_EVENT(LOG_EVENTS, EV_IDLE_TRANSITION, sched->current_time, entry_energy,
+                  sleep_states[state].id);
+    }
+    int state = sched->sleep_state;
+    long long idle_energy = (long long)idle_duration * sleep_states[state].power;
+    sched->total_energy += idle_energy;
+    sched->sleep_time[state] += idle_duration;
+    sched->sleep_energy[state] += idle_energy;
+    sched->current_time = time;
+    LOG_EVENT(LOG_EVENTS, EV_FAST_FORWARD,
+              sched->current_time, idle_duration, idle_energy, sleep_states[state].id);
+}
+
+/* Pays the exit energy of the state the CPU slept in. */
+static int wake_up(Scheduler *sched) {
+    int exit_energy = sleep_states[sched->sleep_state].exit_energy;
+    sched->active = 1;
+    sched->sleep_energy[sched->sleep_state] += exit_energy;
+    return exit_energy;
+}
+
+/* The batch is every ready task at the highest ready priority. The ready
+   heap orders ties by exec time, so popping the level runs the batch
+   shortest first; tasks arriving meanwhile wait for the next batch. */
+int run_next_batch(Scheduler *sched) {
+    int priority = sched->ready[0].priority;
+    long long batch_energy = 0;
+    int tasks_batched = 0;
+    if (!sched->active) {
+        batch_energy += wake_up(sched);
+    }
+    while (sched->ready_count > 0 && sched->ready[0].priority == priority) {
+        int idx = ready_pop(sched);
+        Task *t = &sched->tasks[idx];
+        t->completed = 1;
+        if (sched->changed) mark_changed(sched, idx);
+        LOG_EVENT(LOG_EVENTS, EV_TASK_BATCHED,
+                  sched->current_time + t->exec_time, t->task_id, t->priority, t->exec_time);
+        batch_energy += calculate_batch_energy(t->exec_time, sched->active, &sched->active); 
+        sched->current_time += t->exec_time;
+        tasks_batched++;
+    }
+    sched->total_energy += batch_energy;
+    LOG_EVENT(LOG_EVENTS, EV_BATCH_DONE, sched->current_time, batch_energy);
+    return tasks_batched;
+}
+
+/* Runs the next batch, idling first until the next arrival if nothing
+   is ready. Returns the number of tasks run, 0 once nothing is pending. */
+int scheduler_step(Scheduler *sched) {
+    admit_tasks(sched);
+    if (sched->ready_count == 0) {
+        if (sched->future.count == 0) return 0;
+        idle_until(sched, wheel_next_time(&sched->future));
+        admit_tasks(sched);
+    }
+    return run_next_batch(sched);
+}
+
+/* Runs every batch that can start before `time`, then idles up to it.
+   Batches are not preempted, so the clock may end up past `time`. */
+void scheduler_advance(Scheduler *sched, int time) {
+    while (sched->current_time < time) {
+        admit_tasks(sched);
+        if (sched->ready_count > 0) {
+            run_next_batch(sched);
+        } else if (sched->future.count > 0 && wheel_next_time(&sched->future) < time) {
+            idle_until(sched, wheel_next_time(&sched->future));
+        } else {
+            idle_until(sched, time);
+        }
+    }
+}
+
+void scheduler_drain(Scheduler *sched) {
+    while (scheduler_step(sched) > 0) {
+    }
+}
+
+int scheduler_pending(const Scheduler *sched) {
+    return sched->task_count - sched->submitted + sched->future.count + sched->ready_count;
+}
+
+long long scheduler_energy(const Scheduler *sched) {
+    return sched->total_energy;
+}
+
+/* Starts recording which blocks of CHANGE_BLOCK_TASKS tasks are added
+   to or completed, so a checkpoint only has to copy those. Every block
+   starts out changed. Returns 1 on success, 0 if out of memory. */
+int scheduler_track_changes(Scheduler *sched) {
+    int words = CHANGE_WORDS(sched->capacity);
+    uint64_t *changed = realloc(sched->changed, words * sizeof(uint64_t));
+    if (!changed) {
+        fprintf(stderr, "Error: Could not allocate change tracking\n");
+        return 0;
+    }
+    memset(changed, 0xff, words * sizeof(uint64_t));
+    sched->changed = changed;
+    return 1;
+}
+
+/* Refills the arrival wheel and ready heap from the task table, for a
+   scheduler whose tasks and counters were restored between two steps.
+   At that point a submitted task that has not run is ready if it
+   arrived by the wheel's last advance, and on the wheel otherwise. Both
+   queues order their tasks totally, so the rebuilt ones release and pop
+   in exactly the order the originals would have. */
+void scheduler_rebuild_queues(Scheduler *sched, int wheel_now) {
+    wheel_free(&sched->future);
+    sched->queue_capacity = 0;
+    reserve_queues(sched);
+    sched->future.now = wheel_now;
+    sched->ready_count = 0;
+    for (int i = 0; i < sched->submitted; i++) {
+        Task *t = &sched->tasks[i];
+        if (t->completed) continue;
+        if (t->arrival_time <= wheel_now) {
+            ready_push(sched, i);
+        } else {
+            wheel_insert(&sched->future, i, t->arrival_time);
+        }
+    }
+}
+
+void schedule_tasks(Scheduler *sched) {
+    LOG_EVENT(LOG_SUMMARY, EV_SCHEDULE_START, sched->current_time);
+    scheduler_drain(sched);
+    LOG_EVENT(LOG_SUMMARY, EV_SCHEDULE_DONE, sched->total_energy);
+}
+void print_schedule(Scheduler *sched) {
+    LOG_EVENT(LOG_SUMMARY, EV_SCHEDULE_HEADER, 0);
     for (int i = 0; i < sched->task_count; i++) {
-        if (!sched->tasks[i].completed) return 1;
+        LOG_EVENT(LOG_SUMMARY, EV_SCHEDULE_ROW,
+                  sched->tasks[i].task_id, sched->tasks[i].exec_time, 
+                  sched->tasks[i].arrival_time, sched->tasks[i].priority, 
+                  sched->tasks[i].completed);
     }
-    return 0;
+    LOG_EVENT(LOG_SUMMARY, EV_TOTAL_ENERGY, sched->total_energy);
+    LOG_EVENT(LOG_SUMMARY, EV_SLEEP_HEADER, 0);
+    for (int i = 0; i < sleep_state_count; i++) {
+        LOG_EVENT(LOG_SUMMARY, EV_SLEEP_ROW, sleep_states[i].id, sched->sleep_entries[i],
+                  sched->sleep_time[i], sched->sleep_energy[i], sleep_break_even(i));
+    }
+}
+void init_multicore(MultiCoreScheduler *mc, int core_count, PlacementPolicy policy) {
+    memset(mc, 0, sizeof(MultiCoreScheduler));
+    mc->core_count = core_count > 0 ? core_count : 1;
+    mc->policy = policy;
+    mc->pack_backlog_limit = PACK_BACKLOG_LIMIT;
+    mc->cores = calloc(mc->core_count, sizeof(Core));
+    if (!mc->cores) {
+        fprintf(stderr, "Error: Could not allocate %d cores\n", mc->core_count);
+        exit(1);
+    }
+}
+
+void free_multicore(MultiCoreScheduler *mc) {
+    for (int i = 0; i < mc->core_count; i++) {
+        free(mc->cores[i].queue);
+    }
+    free(mc->cores);
+    free(mc->batches);
+    free(mc->batch_tasks);
+    memset(mc, 0, sizeof(MultiCoreScheduler));
 }
 
+int core_backlog(Core *c, int now) {
+    return c->queued_work + (c->free_at > now ? c->free_at - now : 0);
+}
 
-void sort_tasks_by_exec_time(Scheduler *sched, int start, int end) {
-    for (int i = start; i < end - 1; i++) {
-        for (int j = i + 1; j < end; j++) {
-            if (sched->tasks[i].exec_time > sched->tasks[j].exec_time && 
-                sched->tasks[i].priority == sched->tasks[j].priority) {
-                Task temp = sched->tasks[i];
-                sched->tasks[i] = sched->tasks[j];
-                sched->tasks[j] = temp;
+void core_push(MultiCoreScheduler *mc, Core *c, int batch_id) {
+    if (c->tail == c->capacity) {
+        if (c->head > 0) {
+            memmove(c->queue, c->queue + c->head, (c->tail - c->head) * sizeof(int));
+            c->tail -= c->head;
+            c->head = 0;
+        } else {
+            c->capacity = c->capacity ? c->capacity * 2 : 16;
+            c->queue = realloc(c->queue, c->capacity * sizeof(int));
+            if (!c->queue) {
+                fprintf(stderr, "Error: Could not grow core queue\n");
+                exit(1);
             }
         }
     }
+    c->queue[c->tail++] = batch_id;
+    c->queued_work += mc->batches[batch_id].work;
 }
 
+int core_pop(MultiCoreScheduler *mc, Core *c, int from_tail) {
+    if (c->head == c->tail) return -1;
+    int batch_id = from_tail ? c->queue[--c->tail] : c->queue[c->head++];
+    c->queued_work -= mc->batches[batch_id].work;
+    if (c->head == c->tail) c->head = c->tail = 0;
+    return batch_id;
+}
 
-void schedule_tasks(Scheduler *sched) {
-    int active = 0;
-    printf("\nScheduling started at time %dms\n", sched->current_time);
-    fprintf(log_file, "\nScheduling started at time %dms\n", sched->current_time);
-
-    while (has_pending_tasks(sched)) {
-        int batch_energy = 0;
-        int batch_time = 0;
-        int tasks_batched = 0;
-        int max_priority = -1;
-        int batch_start = -1;
-
-     for (int i = 0; i < sched->task_count; i++) {
-            Task *t = &sched->tasks[i];
-            if (!t->completed && t->arrival_time <= sched->current_time) {
-                if (t->priority > max_priority) {
-                    max_priority = t->priority;
-                    batch_energy = batch_time = tasks_batched = 0;
-                    batch_start = i;
-                    for (int j = 0; j <= i; j++) {
-                        Task *tj = &sched->tasks[j];
-                        if (!tj->completed && tj->arrival_time <= sched->current_time && tj->priority == max_priority) {
-                            batch_time += tj->exec_time;
-                            tj->completed = 1;
-                            tasks_batched++;
-                        }
-                    }
-                } else if (t->priority == max_priority) {
-                    batch_time += t->exec_time;
-                    t->completed = 1;
-                    tasks_batched++;
-                }
+int place_batch(MultiCoreScheduler *mc, int now) {
+    int best = 0;
+    for (int i = 0; i < mc->core_count; i++) {
+        int backlog = core_backlog(&mc->cores[i], now);
+        if (mc->policy == PLACE_PACK && backlog < mc->pack_backlog_limit) return i;
+        if (backlog < core_backlog(&mc->cores[best], now)) best = i;
+    }
+    return best;
+}
+
+/* Takes the newest batch from the core with the most queued work. Under
+   PLACE_PACK only cores that have already been woken may steal, so the
+   packed-out cores really do stay asleep. */
+int steal_batch(MultiCoreScheduler *mc, int thief) {
+    if (mc->policy == PLACE_PACK && mc->cores[thief].batches_run == 0) return -1;
+    int victim = -1;
+    for (int i = 0; i < mc->core_count; i++) {
+        Core *c = &mc->cores[i];
+        if (i != thief && c->head != c->tail &&
+            (victim == -1 || c->queued_work > mc->cores[victim].queued_work)) {
+            victim = i;
+        }
+    }
+    if (victim == -1) return -1;
+    mc->cores[thief].steals++;
+    return core_pop(mc, &mc->cores[victim], 1);
+}
+
+/* Starts a batch on a core and returns its energy. */
+long long run_batch(Scheduler *sched, MultiCoreScheduler *mc, int core_id, int batch_id, int now) {
+    Core *c = &mc->cores[core_id];
+    Batch *b = &mc->batches[batch_id];
+    long long batch_energy = 0;
+
+    if (!c->active) {
+        c->idle_time += now - c->idle_since;
+        c->energy += (long long)(now - c->idle_since) * ENERGY_IDLE;
+        c->transitions++;
+    }
+    for (int i = b->first; i < b->first + b->count; i++) {
+        Task *task = &sched->tasks[mc->batch_tasks[i]];
+        batch_energy += calculate_batch_energy(task->exec_time, c->active, &c->active);
+    }
+    c->energy += batch_energy;
+    c->busy_time += b->work;
+    c->free_at = now + b->work;
+    c->batches_run++;
+    return batch_energy;
+}
+
+/* How far the event log has got through the batch a core is running. */
+typedef struct {
+    int batch;          /* -1 once the batch has been logged */
+    int pos;            /* next task of the batch to log */
+    int time;           /* when that task starts */
+    long long energy;   /* of the whole batch */
+} CoreLog;
+
+/* Logs every task that finished on any core by `until`, in time order
+   (lower core first on a tie), and each batch's completion after its
+   last task. The loop only stops at arrivals and batch ends, so runs
+   inside a batch are merged across cores here. */
+static void log_core_runs(Scheduler *sched, MultiCoreScheduler *mc, CoreLog *logs, int until) {
+    for (;;) {
+        int core = -1, end = 0;
+        for (int i = 0; i < mc->core_count; i++) {
+            if (logs[i].batch < 0) continue;
+            int e = logs[i].time + sched->tasks[mc->batch_tasks[logs[i].pos]].exec_time;
+            if (e <= until && (core == -1 || e < end)) {
+                core = i;
+                end = e;
             }
         }
+        if (core == -1) return;
+        CoreLog *l = &logs[core];
+        Task *task = &sched->tasks[mc->batch_tasks[l->pos]];
+        LOG_EVENT(LOG_EVENTS, EV_CORE_RAN, end, core, task->task_id, task->priority, task->exec_time);
+        l->time = end;
+        Batch *b = &mc->batches[l->batch];
+        if (++l->pos == b->first + b->count) {
+            LOG_EVENT(LOG_EVENTS, EV_CORE_BATCH_DONE, end, core, l->energy);
+            l->batch = -1;
+        }
+    }
+}
 
-        if (tasks_batched > 0) {
-            sort_tasks_by_exec_time(sched, batch_start, batch_start + tasks_batched);
-            for (int i = batch_start; i < batch_start + tasks_batched; i++) {
-                Task *t = &sched->tasks[i];
-                printf("Time %dms: Batched Task %d (Priority %d), exec time %dms\n", 
-                       sched->current_time + t->exec_time, t->task_id, t->priority, t->exec_time);
-                fprintf(log_file, "Time %dms: Batched Task %d (Priority %d), exec time %dms\n", 
-                        sched->current_time + t->exec_time, t->task_id, t->priority, t->exec_time);
-                batch_energy += calculate_batch_energy(t->exec_time, active, &active); 
-                sched->current_time += t->exec_time;
+/* Event-driven N-core variant of schedule_tasks(). At each arrival or
+   core completion the newly ready tasks are grouped into one batch per
+   priority level and placed on a core's queue; every free core then runs
+   its next batch, steals one, or powers down. */
+void schedule_tasks_multicore(Scheduler *sched, MultiCoreScheduler *mc) {
+    int n = sched->task_count;
+    int m = 0;
+    ArrivalRef *order = malloc((n > 0 ? n : 1) * sizeof(ArrivalRef));
+    ReadyRef *ready = malloc((n > 0 ? n : 1) * sizeof(ReadyRef));
+    mc->batches = realloc(mc->batches, (n > 0 ? n : 1) * sizeof(Batch));
+    mc->batch_tasks = realloc(mc->batch_tasks, (n > 0 ? n : 1) * sizeof(int));
+    if (!order || !ready || !mc->batches || !mc->batch_tasks) {
+        fprintf(stderr, "Error: Could not allocate multi-core schedule\n");
+        exit(1);
+    }
+    mc->batch_count = 0;
+    CoreLog *logs = NULL;
+    if (LOG_EVENTS <= log_current_level) {
+        logs = malloc(mc->core_count * sizeof(CoreLog));
+        if (!logs) {
+            fprintf(stderr, "Error: Could not allocate multi-core schedule\n");
+            exit(1);
+        }
+        for (int i = 0; i < mc->core_count; i++) {
+            logs[i].batch = -1;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (!sched->tasks[i].completed) {
+            order[m].arrival_time = sched->tasks[i].arrival_time;
+            order[m].idx = i;
+            m++;
+        }
+    }
+    qsort(order, m, sizeof(ArrivalRef), compare_arrival);
+
+    int now = sched->current_time;
+    for (int i = 0; i < mc->core_count; i++) {
+        mc->cores[i].free_at = mc->cores[i].idle_since = now;
+    }
+    LOG_EVENT(LOG_SUMMARY, EV_MC_START, now, mc->core_count, mc->policy == PLACE_PACK);
+
+    int next = 0;
+    for (;;) {
+        if (logs) log_core_runs(sched, mc, logs, now);
+        int ready_count = 0;
+        while (next < m && order[next].arrival_time <= now) {
+            Task *t = &sched->tasks[order[next].idx];
+            ready[ready_count].priority = t->priority;
+            ready[ready_count].exec_time = t->exec_time;
+            ready[ready_count].idx = order[next].idx;
+            t->completed = 1;
+            ready_count++;
+            next++;
+        }
+        qsort(ready, ready_count, sizeof(ReadyRef), compare_ready);
+        int batched = next - ready_count;
+        for (int i = 0; i < ready_count; ) {
+            Batch *b = &mc->batches[mc->batch_count];
+            b->first = batched + i;
+            b->count = 0;
+            b->priority = ready[i].priority;
+            b->work = 0;
+            for (; i < ready_count && ready[i].priority == b->priority; i++) {
+                mc->batch_tasks[b->first + b->count++] = ready[i].idx;
+                b->work += ready[i].exec_time;
             }
-            sched->total_energy += batch_energy;
-            printf("Time %dms: Batch completed, energy +%d\n", sched->current_time, batch_energy);
-            fprintf(log_file, "Time %dms: Batch completed, energy +%d\n", sched->current_time, batch_energy);
-        } else {
-            int next_arrival = -1;
-            for (int i = 0; i < sched->task_count; i++) {
-                if (!sched->tasks[i].completed && 
-                    (next_arrival == -1 || sched->tasks[i].arrival_time < next_arrival)) {
-                    next_arrival = sched->tasks[i].arrival_time;
+            core_push(mc, &mc->cores[place_batch(mc, now)], mc->batch_count++);
+        }
+
+        for (int i = 0; i < mc->core_count; i++) {
+            Core *c = &mc->cores[i];
+            if (c->free_at > now) continue;
+            int batch_id = core_pop(mc, c, 0);
+            if (batch_id < 0) batch_id = steal_batch(mc, i);
+            if (batch_id >= 0) {
+                long long energy = run_batch(sched, mc, i, batch_id, now);
+                if (logs) {
+                    logs[i].batch = batch_id;
+                    logs[i].pos = mc->batches[batch_id].first;
+                    logs[i].time = now;
+                    logs[i].energy = energy;
                 }
+            } else if (c->active) {
+                c->energy += STATE_TRANSITION_PENALTY;
+                c->active = 0;
+                c->transitions++;
+                c->idle_since = now;
+                LOG_EVENT(LOG_EVENTS, EV_CORE_IDLE, now, i, STATE_TRANSITION_PENALTY);
             }
-            if (next_arrival > sched->current_time) {
-                int idle_duration = next_arrival - sched->current_time;
-                if (active) {
-                    sched->total_energy += STATE_TRANSITION_PENALTY;
-                    active = 0;
-                    printf("Time %dms: CPU idle, energy +%d (transition)\n", 
-                           sched->current_time, STATE_TRANSITION_PENALTY);
-                    fprintf(log_file, "Time %dms: CPU idle, energy +%d (transition)\n", 
-                            sched->current_time, STATE_TRANSITION_PENALTY);
-                }
-                sched->total_energy += idle_duration * ENERGY_IDLE;
-                sched->current_time = next_arrival;
-                printf("Time %dms: Fast-forwarded %dms, energy +%d (idle)\n", 
-                       sched->current_time, idle_duration, idle_duration * ENERGY_IDLE);
-                fprintf(log_file, "Time %dms: Fast-forwarded %dms, energy +%d (idle)\n", 
-                        sched->current_time, idle_duration, idle_duration * ENERGY_IDLE);
-            } else {
-                if (active) {
-                    sched->total_energy += STATE_TRANSITION_PENALTY;
-                    active = 0;
-                    printf("Time %dms: CPU idle, energy +%d (transition)\n", 
-                           sched->current_time, STATE_TRANSITION_PENALTY);
-                    fprintf(log_file, "Time %dms: CPU idle, energy +%d (transition)\n", 
-                            sched->current_time, STATE_TRANSITION_PENALTY);
-                }
-                sched->total_energy += ENERGY_IDLE;
-                sched->current_time++;
+        }
+
+        int next_time = next < m ? order[next].arrival_time : INT_MAX;
+        for (int i = 0; i < mc->core_count; i++) {
+            if (mc->cores[i].free_at > now && mc->cores[i].free_at < next_time) {
+                next_time = mc->cores[i].free_at;
             }
         }
+        if (next_time == INT_MAX) break;
+        now = next_time;
+    }
+
+    mc->makespan = now;
+    mc->total_energy = 0;
+    for (int i = 0; i < mc->core_count; i++) {
+        Core *c = &mc->cores[i];
+        if (!c->active) {
+            c->idle_time += now - c->idle_since;
+            c->energy += (long long)(now - c->idle_since) * ENERGY_IDLE;
+            c->idle_since = now;
+        }
+        mc->total_energy += c->energy;
     }
-    printf("Scheduling completed. Total energy: %d mJ\n", sched->total_energy);
-    fprintf(log_file, "Scheduling completed. Total energy: %d mJ\n", sched->total_energy);
+    sched->current_time = now;
+    sched->total_energy += mc->total_energy;
+
+    LOG_EVENT(LOG_SUMMARY, EV_MC_DONE, mc->total_energy);
+    free(order);
+    free(ready);
+    free(logs);
 }
-void print_schedule(Scheduler *sched) {
-    printf("\nFinal Schedule:\n");
-    printf("Task ID | Exec Time | Arrival Time | Priority | Completed\n");
-    fprintf(log_file, "\nFinal Schedule:\n");
-    fprintf(log_file, "Task ID | Exec Time | Arrival Time | Priority | Completed\n");
-    for (int i = 0; i < sched->task_count; i++) {
-        printf("%7d | %9d | %12d | %8d | %9d\n", 
-               sched->tasks[i].task_id, sched->tasks[i].exec_time, 
-               sched->tasks[i].arrival_time, sched->tasks[i].priority, 
-               sched->tasks[i].completed);
-        fprintf(log_file, "%7d | %9d | %12d | %8d | %9d\n", 
-                sched->tasks[i].task_id, sched->tasks[i].exec_time, 
-                sched->tasks[i].arrival_time, sched->tasks[i].priority, 
-                sched->tasks[i].completed);
-    }
-    printf("Total Energy Consumed: %d mJ\n", sched->total_energy);
-    fprintf(log_file, "Total Energy Consumed: %d mJ\n", sched->total_energy);
-}
-int main() {
-    log_file = fopen(LOG_FILE, "w");
-    if (!log_file) {
-        fprintf(stderr, "Error: Could not open log file %s\n", LOG_FILE);
+
+void print_multicore_report(MultiCoreScheduler *mc) {
+    LOG_EVENT(LOG_SUMMARY, EV_MC_HEADER, mc->policy == PLACE_PACK);
+    for (int i = 0; i < mc->core_count; i++) {
+        Core *c = &mc->cores[i];
+        LOG_EVENT(LOG_SUMMARY, EV_MC_ROW,
+                  i, c->batches_run, c->steals, c->busy_time, c->idle_time, c->transitions, c->energy);
+    }
+    LOG_EVENT(LOG_SUMMARY, EV_MC_TOTAL, mc->total_energy, mc->makespan);
+}
+#ifndef SCHEDULER_NO_MAIN
+int main(int argc, char *argv[]) {
+    LogLevel level = LOG_EVENTS;
+    int background = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quiet") == 0) level = LOG_QUIET;
+        else if (strcmp(argv[i], "--summary") == 0) level = LOG_SUMMARY;
+        else if (strcmp(argv[i], "--async-log") == 0) background = 1;
+    }
+    if (!log_open(LOG_FILE, level, background)) {
         return 1;
     }
 
     Scheduler sched;
-    printf("Test Case 1: Overlapping arrivals\n");
-    fprintf(log_file, "Test Case 1: Overlapping arrivals\n");
+    LOG_TEXT(LOG_SUMMARY, "Test Case 1: Overlapping arrivals\n");
     init_scheduler(&sched);
     if (add_task(&sched, 1, 2, 0, 5) && 
         add_task(&sched, 2, 3, 1, 10) && 
@@ -205,11 +684,10 @@ int main() {
         schedule_tasks(&sched);
         print_schedule(&sched);
     } else {
-        printf("Test Case 1 failed due to invalid inputs\n");
-        fprintf(log_file, "Test Case 1 failed due to invalid inputs\n");
+        LOG_TEXT(LOG_SUMMARY, "Test Case 1 failed due to invalid inputs\n");
     }
-    printf("\nTest Case 2: Sparse arrivals\n");
-    fprintf(log_file, "\nTest Case 2: Sparse arrivals\n");
+    free_scheduler(&sched);
+    LOG_TEXT(LOG_SUMMARY, "\nTest Case 2: Sparse arrivals\n");
     init_scheduler(&sched);
     if (add_task(&sched, 4, 2, 0, 8) && 
         add_task(&sched, 5, 1, 5, 4) && 
@@ -217,11 +695,47 @@ int main() {
         schedule_tasks(&sched);
         print_schedule(&sched);
     } else {
-        printf("Test Case 2 failed due to invalid inputs\n");
-        fprintf(log_file, "Test Case 2 failed due to invalid inputs\n");
+        LOG_TEXT(LOG_SUMMARY, "Test Case 2 failed due to invalid inputs\n");
     }
 
-    
-    fclose(log_file);
+    free_scheduler(&sched);
+    LOG_TEXT(LOG_SUMMARY, "\nTest Case 3: Live submissions\n");
+    init_scheduler(&sched);
+    if (add_task(&sched, 13, 3, 0, 4) && 
+        add_task(&sched, 14, 2, 1, 4)) {
+        scheduler_advance(&sched, 4);
+        if (add_task(&sched, 15, 1, 4, 9) && 
+            add_task(&sched, 16, 2, 20, 2)) {
+            scheduler_step(&sched);
+            scheduler_drain(&sched);
+            print_schedule(&sched);
+        }
+    } else {
+        LOG_TEXT(LOG_SUMMARY, "Test Case 3 failed due to invalid inputs\n");
+    }
+
+    free_scheduler(&sched);
+    LOG_TEXT(LOG_SUMMARY, "\nTest Case 4: Four cores, spread vs pack\n");
+    for (int policy = PLACE_SPREAD; policy <= PLACE_PACK; policy++) {
+        MultiCoreScheduler mc;
+        init_scheduler(&sched);
+        init_multicore(&mc, 4, (PlacementPolicy)policy);
+        if (add_task(&sched, 7, 4, 0, 5) && 
+            add_task(&sched, 8, 2, 0, 3) && 
+            add_task(&sched, 9, 6, 1, 5) && 
+            add_task(&sched, 10, 3, 2, 7) && 
+            add_task(&sched, 11, 1, 12, 3) && 
+            add_task(&sched, 12, 5, 30, 7)) {
+            schedule_tasks_multicore(&sched, &mc);
+            print_multicore_report(&mc);
+        } else {
+            LOG_TEXT(LOG_SUMMARY, "Test Case 4 failed due to invalid inputs\n");
+        }
+        free_multicore(&mc);
+        free_scheduler(&sched);
+    }
+
+    log_close();
     return 0;
 }
+#endif
@@ -1,6 +1,12 @@
 #ifndef ENERGY_SCHEDULER_H
 #define ENERGY_SCHEDULER_H
-#define MAX_TASKS 100
+#include "timing_wheel.h"
+#include "energy_model.h"
+
+/* Tasks per unit of change tracking; see scheduler_track_changes(). */
+#define CHANGE_BLOCK_TASKS 256
+#define CHANGE_WORDS(tasks) ((tasks) / CHANGE_BLOCK_TASKS / 64 + 1)
+
 typedef struct {
     int task_id;         
     int exec_time;       
@@ -10,14 +16,89 @@ typedef struct {
 } Task;
 
 typedef struct {
-    Task tasks[MAX_TASKS];  
+    int priority;
+    int exec_time;
+    int idx;
+} ReadyRef;
+
+typedef struct {
+    Task *tasks;  
     int task_count;        
-    int total_energy;      
+    int capacity;          
+    long long total_energy;   /* mJ */
     int current_time;       
+    int active;             /* CPU powered up */
+    int submitted;          /* tasks[0..submitted) have been queued */
+    TimingWheel future;     /* tasks not yet arrived, keyed by arrival time */
+    ReadyRef *ready;        /* heap: highest priority, then shortest exec time */
+    int ready_count;
+    int queue_capacity;
+    int sleep_state;        /* state the CPU is in, or last left, while idle */
+    int sleep_entries[MAX_SLEEP_STATES];
+    int sleep_time[MAX_SLEEP_STATES];
+    long long sleep_energy[MAX_SLEEP_STATES];
+    uint64_t *changed;      /* bit per block of tasks added or completed since
+                               the last checkpoint; NULL unless tracking */
 } Scheduler;
 
+typedef enum {
+    PLACE_SPREAD,   /* least-loaded core first, any idle core may steal */
+    PLACE_PACK      /* fill low-numbered cores first, sleeping cores stay asleep */
+} PlacementPolicy;
+
+typedef struct {
+    int first;      /* offset into MultiCoreScheduler.batch_tasks */
+    int count;
+    int priority;
+    int work;       /* total exec time of the batch */
+} Batch;
+
+typedef struct {
+    int *queue;     /* batch ids; owner pops from head, thieves take from tail */
+    int head;
+    int tail;
+    int capacity;
+    int queued_work;
+    int active;
+    int free_at;
+    int idle_since;
+    long long energy;
+    int busy_time;
+    int idle_time;
+    int transitions;
+    int batches_run;
+    int steals;
+} Core;
+
+typedef struct {
+    Core *cores;
+    int core_count;
+    PlacementPolicy policy;
+    int pack_backlog_limit;
+    Batch *batches;
+    int *batch_tasks;
+    int batch_count;
+    long long total_energy;
+    int makespan;
+} MultiCoreScheduler;
+
+int set_sleep_states(const SleepState *states, int count);
+int sleep_break_even(int state);
+int get_sleep_states(SleepState *states);
 void init_scheduler(Scheduler *sched);
+void free_scheduler(Scheduler *sched);
 int add_task(Scheduler *sched, int id, int exec_time, int arrival_time, int priority);
 void schedule_tasks(Scheduler *sched);
+int scheduler_step(Scheduler *sched);
+void scheduler_advance(Scheduler *sched, int time);
+void scheduler_drain(Scheduler *sched);
+int scheduler_pending(const Scheduler *sched);
+long long scheduler_energy(const Scheduler *sched);
+int scheduler_track_changes(Scheduler *sched);
+void scheduler_rebuild_queues(Scheduler *sched, int wheel_now);
 void print_schedule(Scheduler *sched);
+void init_multicore(MultiCoreScheduler *mc, int core_count, PlacementPolicy policy);
+void free_multicore(MultiCoreScheduler *mc);
+void schedule_tasks_multicore(Scheduler *sched, MultiCoreScheduler *mc);
+void print_multicore_report(MultiCoreScheduler *mc);
 #endif
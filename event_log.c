@@ -0,0 +1,270 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "event_log.h"
+
+#define LOG_LINE_MAX 192
+
+LogLevel log_current_level = LOG_EVENTS;
+
+static FILE *log_file;
+static LogEvent ring[LOG_RING_BLOCKS][LOG_BLOCK_EVENTS];
+static int block_count[LOG_RING_BLOCKS];   /* events in a submitted block, 0 when free */
+static int fill_block;
+static int fill_count;
+static int write_block;
+static char *file_text;
+static char *stdout_text;
+static int log_is_open;
+static FILE *spool;             /* full blocks not yet formatted, or NULL */
+static LogEvent *spool_events;  /* read-back buffer, one block */
+
+static int background;
+static int stopping;
+static pthread_t writer;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t block_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t block_free = PTHREAD_COND_INITIALIZER;
+
+static const char *policy_name(long long policy) {
+    return policy ? "pack" : "spread";
+}
+
+static int format_event(char *out, const LogEvent *ev) {
+    const long long *a = ev->u.arg;
+    switch (ev->type) {
+        case EV_TEXT:
+            return snprintf(out, LOG_LINE_MAX, "%s", ev->u.text);
+        case EV_ERROR_QUEUE_FULL:
+            return snprintf(out, LOG_LINE_MAX, "Error: Task queue full\n");
+        case EV_ERROR_INVALID_TASK:
+            return snprintf(out, LOG_LINE_MAX,
+                            "Error: Invalid task parameters (id=%lld, exec_time=%lld, arrival=%lld, priority=%lld)\n",
+                            a[0], a[1], a[2], a[3]);
+        case EV_TASK_ADDED:
+            return snprintf(out, LOG_LINE_MAX,
+                            "Added Task %lld: Exec Time = %lldms, Arrival = %lldms, Priority = %lld\n",
+                            a[0], a[1], a[2], a[3]);
+        case EV_SCHEDULE_START:
+            return snprintf(out, LOG_LINE_MAX, "\nScheduling started at time %lldms\n", a[0]);
+        case EV_TASK_BATCHED:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Batched Task %lld (Priority %lld), exec time %lldms\n",
+                            a[0], a[1], a[2], a[3]);
+        case EV_BATCH_DONE:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Batch completed, energy +%lld\n", a[0], a[1]);
+        case EV_IDLE_TRANSITION:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: CPU idle in C%lld, energy +%lld (transition)\n",
+                            a[0], a[2], a[1]);
+        case EV_FAST_FORWARD:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Fast-forwarded %lldms, energy +%lld (idle in C%lld)\n",
+                            a[0], a[1], a[2], a[3]);
+        case EV_SCHEDULE_DONE:
+            return snprintf(out, LOG_LINE_MAX, "Scheduling completed. Total energy: %lld mJ\n", a[0]);
+        case EV_SCHEDULE_HEADER:
+            return snprintf(out, LOG_LINE_MAX,
+                            "\nFinal Schedule:\nTask ID | Exec Time | Arrival Time | Priority | Completed\n");
+        case EV_SCHEDULE_ROW:
+            return snprintf(out, LOG_LINE_MAX, "%7lld | %9lld | %12lld | %8lld | %9lld\n",
+                            a[0], a[1], a[2], a[3], a[4]);
+        case EV_TOTAL_ENERGY:
+            return snprintf(out, LOG_LINE_MAX, "Total Energy Consumed: %lld mJ\n", a[0]);
+        case EV_SLEEP_HEADER:
+            return snprintf(out, LOG_LINE_MAX,
+                            "\nIdle Time by Sleep State:\nState | Entries | Time (ms) | Energy | Break-even (ms)\n");
+        case EV_SLEEP_ROW:
+            return snprintf(out, LOG_LINE_MAX, " C%-3lld | %7lld | %9lld | %6lld | %15lld\n",
+                            a[0], a[1], a[2], a[3], a[4]);
+        case EV_MC_START:
+            return snprintf(out, LOG_LINE_MAX, "\nMulti-core scheduling started at time %lldms on %lld cores (%s)\n",
+                            a[0], a[1], policy_name(a[2]));
+        case EV_CORE_RAN:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Core %lld ran Task %lld (Priority %lld), exec time %lldms\n",
+                            a[0], a[1], a[2], a[3], a[4]);
+        case EV_CORE_BATCH_DONE:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Core %lld batch completed, energy +%lld\n",
+                            a[0], a[1], a[2]);
+        case EV_CORE_IDLE:
+            return snprintf(out, LOG_LINE_MAX, "Time %lldms: Core %lld idle, energy +%lld (transition)\n",
+                            a[0], a[1], a[2]);
+        case EV_MC_DONE:
+            return snprintf(out, LOG_LINE_MAX, "Multi-core scheduling completed. Total energy: %lld mJ\n", a[0]);
+        case EV_MC_HEADER:
+            return snprintf(out, LOG_LINE_MAX,
+                            "\nPer-Core Energy (%s placement):\n"
+                            "Core | Batches | Steals | Busy Time | Idle Time | Transitions | Energy\n",
+                            policy_name(a[0]));
+        case EV_MC_ROW:
+            return snprintf(out, LOG_LINE_MAX, "%4lld | %7lld | %6lld | %9lld | %9lld | %11lld | %6lld\n",
+                            a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+        case EV_MC_TOTAL:
+            return snprintf(out, LOG_LINE_MAX, "Total Energy Consumed: %lld mJ over %lldms\n", a[0], a[1]);
+        default:
+            return 0;
+    }
+}
+
+/* Formats one block and writes it with a single fwrite per stream.
+   Errors were already printed to stderr by the caller, so they only go
+   to the log file. */
+static void write_events(const LogEvent *events, int count) {
+    size_t file_len = 0, stdout_len = 0;
+    for (int i = 0; i < count; i++) {
+        int n = format_event(file_text + file_len, &events[i]);
+        if (n >= LOG_LINE_MAX) n = LOG_LINE_MAX - 1;
+        if (events[i].type != EV_ERROR_QUEUE_FULL && events[i].type != EV_ERROR_INVALID_TASK) {
+            memcpy(stdout_text + stdout_len, file_text + file_len, n);
+            stdout_len += n;
+        }
+        file_len += n;
+    }
+    fwrite(stdout_text, 1, stdout_len, stdout);
+    if (log_file) fwrite(file_text, 1, file_len, log_file);
+}
+
+/* Formats everything in the spool, in order, and discards it. */
+static void drain_spool(void) {
+    if (!spool) return;
+    rewind(spool);
+    size_t n;
+    while ((n = fread(spool_events, sizeof(LogEvent), LOG_BLOCK_EVENTS, spool)) > 0) {
+        write_events(spool_events, (int)n);
+    }
+    fclose(spool);
+    spool = NULL;
+}
+
+/* Appends a full block to the spool unformatted. If no spool can be
+   opened or written, it and the block are formatted right away. */
+static void spool_block(const LogEvent *events, int count) {
+    if (!spool) spool = tmpfile();
+    size_t written = spool ? fwrite(events, sizeof(LogEvent), count, spool) : 0;
+    if (written == (size_t)count) return;
+    drain_spool();
+    write_events(events + written, count - (int)written);
+}
+
+static void *writer_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (block_count[write_block] == 0 && !stopping) {
+            pthread_cond_wait(&block_ready, &lock);
+        }
+        if (block_count[write_block] == 0) break;
+        int count = block_count[write_block];
+        pthread_mutex_unlock(&lock);
+
+        spool_block(ring[write_block], count);
+
+        pthread_mutex_lock(&lock);
+        block_count[write_block] = 0;
+        write_block = (write_block + 1) % LOG_RING_BLOCKS;
+        pthread_cond_broadcast(&block_free);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+/* Hands the block being filled to the writer (or spools it inline) and
+   moves on to the next one, waiting only if the writer is a full ring
+   behind. */
+static void submit_block(void) {
+    if (fill_count == 0) return;
+    if (!background) {
+        spool_block(ring[fill_block], fill_count);
+        fill_count = 0;
+        return;
+    }
+    pthread_mutex_lock(&lock);
+    block_count[fill_block] = fill_count;
+    pthread_cond_signal(&block_ready);
+    fill_block = (fill_block + 1) % LOG_RING_BLOCKS;
+    while (block_count[fill_block] != 0) {
+        pthread_cond_wait(&block_free, &lock);
+    }
+    pthread_mutex_unlock(&lock);
+    fill_count = 0;
+}
+
+int log_open(const char *path, LogLevel level, int use_background) {
+    file_text = malloc((size_t)LOG_BLOCK_EVENTS * LOG_LINE_MAX);
+    stdout_text = malloc((size_t)LOG_BLOCK_EVENTS * LOG_LINE_MAX);
+    spool_events = malloc(LOG_BLOCK_EVENTS * sizeof(LogEvent));
+    if (!file_text || !stdout_text || !spool_events) {
+        fprintf(stderr, "Error: Could not allocate log buffers\n");
+        return 0;
+    }
+    if (path) {
+        log_file = fopen(path, "w");
+        if (!log_file) {
+            fprintf(stderr, "Error: Could not open log file %s\n", path);
+            return 0;
+        }
+    }
+    log_current_level = level;
+    fill_block = fill_count = write_block = 0;
+    stopping = 0;
+    background = use_background;
+    if (background && pthread_create(&writer, NULL, writer_main, NULL) != 0) {
+        background = 0;
+    }
+    log_is_open = 1;
+    return 1;
+}
+
+void log_set_level(LogLevel level) {
+    log_current_level = level;
+}
+
+void log_record(const LogEvent *ev) {
+    if (!log_is_open) return;
+    ring[fill_block][fill_count++] = *ev;
+    if (fill_count == LOG_BLOCK_EVENTS) {
+        submit_block();
+    }
+}
+
+/* Formats and writes everything recorded so far: the spool first, then
+   the block still being filled. */
+void log_flush(void) {
+    if (background) {
+        submit_block();
+        pthread_mutex_lock(&lock);
+        for (int i = 0; i < LOG_RING_BLOCKS; i++) {
+            while (block_count[i] != 0) {
+                pthread_cond_wait(&block_free, &lock);
+            }
+        }
+        pthread_mutex_unlock(&lock);
+    }
+    drain_spool();
+    if (fill_count > 0) {
+        write_events(ring[fill_block], fill_count);
+        fill_count = 0;
+    }
+    fflush(stdout);
+    if (log_file) fflush(log_file);
+}
+
+void log_close(void) {
+    log_flush();
+    if (background) {
+        pthread_mutex_lock(&lock);
+        stopping = 1;
+        pthread_cond_signal(&block_ready);
+        pthread_mutex_unlock(&lock);
+        pthread_join(writer, NULL);
+        background = 0;
+    }
+    if (log_file) {
+        fclose(log_file);
+        log_file = NULL;
+    }
+    free(file_text);
+    free(stdout_text);
+    free(spool_events);
+    file_text = stdout_text = NULL;
+    spool_events = NULL;
+    log_is_open = 0;
+}
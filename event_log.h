@@ -0,0 +1,85 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+/*
+ * Buffered event log for the energy scheduler.
+ *
+ * Schedulers record fixed-size binary events instead of formatting text.
+ * Events collect in a block of the ring. A full block is appended as is
+ * to a temporary spool file, inline or by a background writer. Nothing
+ * is turned into text until log_flush() or log_close(), which format the
+ * spool and the current block and write them to stdout and the log file
+ * in one write per block. If no spool can be written, blocks are
+ * formatted as they fill. Events above the current level are dropped at
+ * the call site by LOG_EVENT, so quiet runs only pay for one comparison
+ * per event. Recording before log_open() does nothing.
+ */
+
+#define LOG_BLOCK_EVENTS 16384
+#define LOG_RING_BLOCKS 4
+
+typedef enum {
+    LOG_QUIET = 0,     /* errors only; schedulers just compute totals */
+    LOG_SUMMARY = 1,   /* run start/end, final tables, test case banners */
+    LOG_EVENTS = 2     /* every task, batch and idle event */
+} LogLevel;
+
+typedef enum {
+    EV_TEXT,               /* text: static string, written verbatim */
+    EV_ERROR_QUEUE_FULL,
+    EV_ERROR_INVALID_TASK, /* id, exec_time, arrival, priority */
+    EV_TASK_ADDED,         /* id, exec_time, arrival, priority */
+    EV_SCHEDULE_START,     /* time */
+    EV_TASK_BATCHED,       /* time, id, priority, exec_time */
+    EV_BATCH_DONE,         /* time, energy */
+    EV_IDLE_TRANSITION,    /* time, energy, sleep state */
+    EV_FAST_FORWARD,       /* time, duration, energy, sleep state */
+    EV_SCHEDULE_DONE,      /* energy */
+    EV_SCHEDULE_HEADER,
+    EV_SCHEDULE_ROW,       /* id, exec_time, arrival, priority, completed */
+    EV_TOTAL_ENERGY,       /* energy */
+    EV_SLEEP_HEADER,
+    EV_SLEEP_ROW,          /* sleep state, entries, time, energy, break-even gap */
+    EV_MC_START,           /* time, cores, policy */
+    EV_CORE_RAN,           /* time, core, id, priority, exec_time */
+    EV_CORE_BATCH_DONE,    /* time, core, energy */
+    EV_CORE_IDLE,          /* time, core, energy */
+    EV_MC_DONE,            /* energy */
+    EV_MC_HEADER,          /* policy */
+    EV_MC_ROW,             /* core, batches, steals, busy, idle, transitions, energy */
+    EV_MC_TOTAL            /* energy, makespan */
+} EventType;
+
+typedef struct {
+    int type;
+    union {
+        long long arg[7];   /* wide enough for energy totals */
+        const char *text;
+    } u;
+} LogEvent;
+
+extern LogLevel log_current_level;
+
+#define LOG_EVENT(level, type, ...) \
+    do { \
+        if ((level) <= log_current_level) { \
+            LogEvent ev_ = {(type), {.arg = {__VA_ARGS__}}}; \
+            log_record(&ev_); \
+        } \
+    } while (0)
+
+#define LOG_TEXT(level, str) \
+    do { \
+        if ((level) <= log_current_level) { \
+            LogEvent ev_ = {EV_TEXT, {.text = (str)}}; \
+            log_record(&ev_); \
+        } \
+    } while (0)
+
+int log_open(const char *path, LogLevel level, int background);
+void log_set_level(LogLevel level);
+void log_record(const LogEvent *ev);
+void log_flush(void);
+void log_close(void);
+
+#endif
@@ -0,0 +1,77 @@
+/* Every scheduling algorithm in the repo, expressed for the policy engine.
+   Bind a task type (see policy_engine.h), define ENGINE_PREFIX and
+   ENGINE_CATALOG_ENERGY, and include this to generate ENGINE_PREFIX##fcfs
+   and the rest under that energy model. No include guard: include it once
+   per prefix. Priorities follow their source: CPU.c runs the lowest number
+   first, energy_scheduler.c the highest. */
+
+#include "policy_engine.h"
+
+#define ENGINE_FN(name) ENGINE_CAT(ENGINE_PREFIX, name)
+
+/* CPU.c */
+#define ENGINE_NAME ENGINE_FN(fcfs)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_FIFO_LEVELS 1
+#include "policy_engine_loop.h"
+
+#define ENGINE_NAME ENGINE_FN(sjf)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) ENGINE_BURST(t)
+#include "policy_engine_loop.h"
+
+#define ENGINE_NAME ENGINE_FN(srtf)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) (remaining)
+#define ENGINE_PREEMPTIVE 1
+#include "policy_engine_loop.h"
+
+#define ENGINE_NAME ENGINE_FN(round_robin)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_FIFO_LEVELS 1
+#define ENGINE_RUN_LENGTH(t, remaining, level) ((remaining) > quantum ? quantum : (remaining))
+#include "policy_engine_loop.h"
+
+#define ENGINE_NAME ENGINE_FN(priority_preemptive)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) ENGINE_PRIORITY(t)
+#define ENGINE_PREEMPTIVE 1
+#include "policy_engine_loop.h"
+
+#define ENGINE_NAME ENGINE_FN(priority_non_preemptive)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) ENGINE_PRIORITY(t)
+#include "policy_engine_loop.h"
+
+/* Level L runs slices of quantum << L and finishes a task whose remainder
+   fits in one and a half slices; quantum must be at least 1. */
+#define ENGINE_NAME ENGINE_FN(mlfq)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_FIFO_LEVELS MLFQ_LEVELS
+#define ENGINE_RUN_LENGTH(t, remaining, level) \
+    ((remaining) <= (quantum << (level)) + (quantum << (level)) / 2 ? (remaining) : quantum << (level))
+#define ENGINE_BOOST_PERIOD ((long long)quantum * MLFQ_BOOST_QUANTA)
+#include "policy_engine_loop.h"
+
+/* energy_scheduler.c: batches of every ready task at the highest
+   priority, shortest first. Bursts past 2^20 ms sort as equal. */
+#define ENGINE_NAME ENGINE_FN(batch)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) \
+    ((1023 - (ENGINE_PRIORITY(t) < 1023 ? ENGINE_PRIORITY(t) : 1023)) << 20 | \
+     (ENGINE_BURST(t) < (1 << 20) ? ENGINE_BURST(t) : (1 << 20) - 1))
+#define ENGINE_BATCH_KEY(t) ENGINE_PRIORITY(t)
+#include "policy_engine_loop.h"
+
+/* simulation_engine.c */
+#ifdef ENGINE_DEADLINE
+#define ENGINE_NAME ENGINE_FN(edf)
+#define ENGINE_ENERGY ENGINE_CATALOG_ENERGY
+#define ENGINE_HEAP_KEY(t, remaining) ENGINE_DEADLINE(t)
+#define ENGINE_PREEMPTIVE 1
+#include "policy_engine_loop.h"
+#endif
+
+#undef ENGINE_FN
+#undef ENGINE_PREFIX
+#undef ENGINE_CATALOG_ENERGY
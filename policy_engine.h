@@ -0,0 +1,96 @@
+#ifndef POLICY_ENGINE_H
+#define POLICY_ENGINE_H
+
+#include "energy_model.h"
+#include "pstate_table.h"
+
+/*
+ * Compile-time specialized scheduling loop.
+ *
+ * policy_engine_loop.h is a template. Define the ENGINE_* parameters
+ * below and include it to generate
+ *
+ *     static inline void ENGINE_NAME(ENGINE_TASK *tasks, int count, int quantum,
+ *                                    ENGINE_CONTEXT *context, EngineStats *stats)
+ *
+ * over the caller's own task type, which must be sorted by arrival. Every
+ * parameter is a macro expanded into the loop, so a specialization is a
+ * plain function with its policy, preemption rule and energy model
+ * inlined: there are no per-decision indirect calls. A heap policy is
+ * built once per argmin kernel (argmin.h) and picks one when called, so
+ * its pops are direct calls too. policy_catalog.h
+ * expresses each existing algorithm this way.
+ *
+ * Task binding (stays defined, so one file can generate many policies):
+ *   ENGINE_TASK                     the caller's task type
+ *   ENGINE_ARRIVAL(t), ENGINE_BURST(t)
+ *   ENGINE_REMAINING(t)             int lvalue the loop keeps remaining time in
+ *   ENGINE_PRIORITY(t)              used by the priority and batch policies
+ *   ENGINE_DEADLINE(t)              optional; misses are counted if defined
+ *   ENGINE_CONTEXT                  optional type handed to the hooks (void)
+ *   ENGINE_ON_DISPATCH(i, time, first)  CPU switches to task i
+ *   ENGINE_ON_PREEMPT(i, time)      task i lost the CPU unfinished
+ *   ENGINE_ON_COMPLETE(i, time)
+ *   ENGINE_ON_RUN(i, start, end)    task i ran over [start, end)
+ *
+ * Policy (undefined again by the template):
+ *   ENGINE_NAME
+ *   ENGINE_ENERGY                   NONE, TIMELINE, BATCH or DVFS
+ *   ENGINE_HEAP_KEY(t, remaining)   ready tasks in a min-heap on (key, index), or
+ *   ENGINE_FIFO_LEVELS              that many FIFO queues, lowest level first
+ *   ENGINE_PREEMPTIVE               heap: an arrival with a smaller key preempts
+ *   ENGINE_BATCH_KEY(t)             heap: admit arrivals only once no ready task
+ *                                   shares the running batch's key
+ *   ENGINE_RUN_LENGTH(t, remaining, level)  FIFO: run this long, then requeue
+ *                                   one level down
+ *   ENGINE_BOOST_PERIOD             FIFO: return every task to level 0 this often
+ */
+
+typedef struct {
+    double energy;          /* mJ under ENGINE_ENERGY */
+    int makespan;
+    int context_switches;
+    int idle_periods;
+    int deadline_misses;
+} EngineStats;
+
+/* Energy models. START is the idle lead-in before the first run (the CPU
+   starts asleep), GAP an idle gap between runs, SWITCH a change of task
+   with no gap, and RUN active time of a task with the given burst.
+   TIMELINE is timeline_energy() in CPU.c. BATCH is energy_scheduler.c
+   with only its C1 sleep state: a task change inside a batch is free.
+   DVFS is simulation_engine.c at the top state of its default P-state
+   table (pstate_table.h), which has no transition costs. NONE skips the accounting, leaving stats with only
+   the makespan and deadline misses. */
+#define ENGINE_NONE_TRACKED 0
+#define ENGINE_NONE_START(gap) 0.0
+#define ENGINE_NONE_GAP(gap) 0.0
+#define ENGINE_NONE_SWITCH 0.0
+#define ENGINE_NONE_RUN(burst, len) 0.0
+
+#define ENGINE_TIMELINE_TRACKED 1
+#define ENGINE_TIMELINE_START(gap) ((double)(gap) * ENERGY_IDLE + STATE_TRANSITION_PENALTY)
+#define ENGINE_TIMELINE_GAP(gap) (2.0 * STATE_TRANSITION_PENALTY + (double)(gap) * ENERGY_IDLE)
+#define ENGINE_TIMELINE_SWITCH ((double)STATE_TRANSITION_PENALTY)
+#define ENGINE_TIMELINE_RUN(burst, len) \
+    ((double)(len) * ((burst) < 2 ? ENERGY_ACTIVE_BASE / 2 : ENERGY_ACTIVE_BASE))
+
+#define ENGINE_BATCH_TRACKED 1
+#define ENGINE_BATCH_START(gap) ENGINE_TIMELINE_START(gap)
+#define ENGINE_BATCH_GAP(gap) ENGINE_TIMELINE_GAP(gap)
+#define ENGINE_BATCH_SWITCH 0.0
+#define ENGINE_BATCH_RUN(burst, len) ENGINE_TIMELINE_RUN(burst, len)
+
+#define ENGINE_DVFS_ACTIVE_POWER DEFAULT_TOP_PSTATE_POWER
+#define ENGINE_DVFS_IDLE_POWER DEFAULT_IDLE_POWER
+#define ENGINE_DVFS_TRACKED 1
+#define ENGINE_DVFS_START(gap) ((double)(gap) * ENGINE_DVFS_IDLE_POWER)
+#define ENGINE_DVFS_GAP(gap) ((double)(gap) * ENGINE_DVFS_IDLE_POWER)
+#define ENGINE_DVFS_SWITCH 0.0
+#define ENGINE_DVFS_RUN(burst, len) ((double)(len) * ENGINE_DVFS_ACTIVE_POWER)
+
+#define ENGINE_CAT_(a, b) a##b
+#define ENGINE_CAT(a, b) ENGINE_CAT_(a, b)
+#define ENGINE_MODEL(part) ENGINE_CAT(ENGINE_CAT(ENGINE_, ENGINE_ENERGY), part)
+
+#endif
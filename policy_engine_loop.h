@@ -0,0 +1,309 @@
+/* Template for one scheduler specialization; see policy_engine.h. There
+   is deliberately no include guard: each inclusion generates a function. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "ready_queue.h"
+#include "policy_engine.h"
+
+#if defined(ENGINE_HEAP_KEY) == defined(ENGINE_FIFO_LEVELS)
+#error "define exactly one of ENGINE_HEAP_KEY and ENGINE_FIFO_LEVELS"
+#endif
+
+#ifndef ENGINE_CONTEXT
+#define ENGINE_CONTEXT void
+#endif
+#ifndef ENGINE_PREEMPTIVE
+#define ENGINE_PREEMPTIVE 0
+#endif
+#ifndef ENGINE_ON_DISPATCH
+#define ENGINE_ON_DISPATCH(i, time, first) ((void)0)
+#endif
+#ifndef ENGINE_ON_PREEMPT
+#define ENGINE_ON_PREEMPT(i, time) ((void)0)
+#endif
+#ifndef ENGINE_ON_COMPLETE
+#define ENGINE_ON_COMPLETE(i, time) ((void)0)
+#endif
+#ifndef ENGINE_ON_RUN
+#define ENGINE_ON_RUN(i, start, end) ((void)0)
+#endif
+
+/* A single FIFO level whose tasks always run to completion serves them
+   in arrival order, so there is no queue: the next task is the next
+   index, and an idle CPU just jumps to its arrival. */
+#if defined(ENGINE_FIFO_LEVELS) && ENGINE_FIFO_LEVELS == 1 && !defined(ENGINE_RUN_LENGTH)
+#define ENGINE_IN_ORDER 1
+#else
+#define ENGINE_IN_ORDER 0
+#endif
+#ifndef ENGINE_RUN_LENGTH
+#define ENGINE_RUN_LENGTH(t, remaining, level) (remaining)
+#endif
+
+/* Without preemption or slices every dispatch runs a task to completion,
+   so remaining time never needs tracking. */
+#if ENGINE_IN_ORDER || (defined(ENGINE_HEAP_KEY) && !ENGINE_PREEMPTIVE)
+#define ENGINE_TO_COMPLETION 1
+#else
+#define ENGINE_TO_COMPLETION 0
+#endif
+
+/* The loop itself, built once per argmin kernel for a heap policy. */
+static inline __attribute__((always_inline))
+void ENGINE_CAT(ENGINE_NAME, _with)(ENGINE_TASK *tasks, int count, int quantum,
+                                    ENGINE_CONTEXT *context, EngineStats *stats,
+                                    ArgminKernel kernel) {
+    int time = 0, completed = 0, next = 0;
+    int running = -1, prev = -1;
+    int last_run = -1, last_end = 0;
+    (void)quantum;
+    (void)context;
+    (void)kernel;
+    memset(stats, 0, sizeof(EngineStats));
+
+#if !ENGINE_TO_COMPLETION
+    for (int i = 0; i < count; i++) {
+        ENGINE_REMAINING(&tasks[i]) = ENGINE_BURST(&tasks[i]);
+    }
+#endif
+
+#ifdef ENGINE_HEAP_KEY
+    ReadyQueue rq;
+    rq_init(&rq, count);
+#ifdef ENGINE_BATCH_KEY
+    int batch = 0;
+#endif
+#define ENGINE_ADMIT() \
+    while (next < count && ENGINE_ARRIVAL(&tasks[next]) <= time) { \
+        rq_push(&rq, ENGINE_HEAP_KEY(&tasks[next], ENGINE_BURST(&tasks[next])), next); \
+        next++; \
+    }
+#define ENGINE_READY() (rq.size > 0)
+#elif ENGINE_IN_ORDER
+    int served = 0;
+#define ENGINE_ADMIT() ((void)0)
+#define ENGINE_READY() 1
+#else
+    int *link = malloc((count > 0 ? count : 1) * sizeof(int));
+    int head[ENGINE_FIFO_LEVELS], tail[ENGINE_FIFO_LEVELS];
+    for (int l = 0; l < ENGINE_FIFO_LEVELS; l++) {
+        head[l] = tail[l] = -1;
+    }
+#if ENGINE_FIFO_LEVELS > 1
+    int *level = malloc((count > 0 ? count : 1) * sizeof(int));
+    int *epoch = malloc((count > 0 ? count : 1) * sizeof(int));
+    int boost_epoch = 0;
+    if (!level || !epoch) link = NULL;
+#define ENGINE_ENQUEUE(idx, lvl) \
+    do { \
+        level[idx] = (lvl); \
+        epoch[idx] = boost_epoch; \
+        link[idx] = -1; \
+        if (tail[lvl] == -1) head[lvl] = (idx); else link[tail[lvl]] = (idx); \
+        tail[lvl] = (idx); \
+    } while (0)
+#else
+#define ENGINE_ENQUEUE(idx, lvl) \
+    do { \
+        link[idx] = -1; \
+        if (tail[0] == -1) head[0] = (idx); else link[tail[0]] = (idx); \
+        tail[0] = (idx); \
+    } while (0)
+#endif
+    if (!link) {
+        printf("Error allocating scheduler queues\n");
+        exit(1);
+    }
+#ifdef ENGINE_BOOST_PERIOD
+    long long boost_period = ENGINE_BOOST_PERIOD;
+    long long next_boost = boost_period;
+#endif
+#define ENGINE_ADMIT() \
+    while (next < count && ENGINE_ARRIVAL(&tasks[next]) <= time) { \
+        ENGINE_ENQUEUE(next, 0); \
+        next++; \
+    }
+#define ENGINE_READY() (ready_level < ENGINE_FIFO_LEVELS)
+#endif
+
+    while (completed != count) {
+#if defined(ENGINE_HEAP_KEY) && defined(ENGINE_BATCH_KEY)
+        if (rq.size == 0 || ENGINE_BATCH_KEY(&tasks[rq_top(&rq).idx]) != batch) {
+            ENGINE_ADMIT();
+        }
+#else
+        ENGINE_ADMIT();
+#endif
+#if defined(ENGINE_FIFO_LEVELS) && !ENGINE_IN_ORDER
+        int ready_level = 0;
+        while (ready_level < ENGINE_FIFO_LEVELS && head[ready_level] == -1) ready_level++;
+#endif
+
+        if (running == -1 && !ENGINE_READY()) {
+            time = ENGINE_ARRIVAL(&tasks[next]);
+            continue;
+        }
+
+        /* Pick the task to run. */
+        int lvl = 0;
+#ifdef ENGINE_HEAP_KEY
+        if (rq.size > 0) {
+#if ENGINE_PREEMPTIVE
+            ReadyEntry current = {INT_MAX, INT_MAX};
+            if (running != -1) {
+                current.key = ENGINE_HEAP_KEY(&tasks[running], ENGINE_REMAINING(&tasks[running]));
+                current.idx = running;
+            }
+            if (rq_less(rq_top(&rq), current)) {
+                if (running != -1) {
+                    rq_push(&rq, current.key, current.idx);
+                }
+                running = rq_pop(&rq, kernel).idx;
+            }
+#else
+            if (running == -1) running = rq_pop(&rq, kernel).idx;
+#endif
+        }
+#ifdef ENGINE_BATCH_KEY
+        batch = ENGINE_BATCH_KEY(&tasks[running]);
+#endif
+#elif ENGINE_IN_ORDER
+        running = served++;
+        if (time < ENGINE_ARRIVAL(&tasks[running])) time = ENGINE_ARRIVAL(&tasks[running]);
+#else
+#ifdef ENGINE_BOOST_PERIOD
+        if (time >= next_boost) {
+            for (int k = 1; k < ENGINE_FIFO_LEVELS; k++) {
+                if (head[k] == -1) continue;
+                if (tail[0] == -1) head[0] = head[k]; else link[tail[0]] = head[k];
+                tail[0] = tail[k];
+                head[k] = tail[k] = -1;
+            }
+            boost_epoch++;
+            next_boost = (time / boost_period + 1) * boost_period;
+            ready_level = 0;
+        }
+#endif
+        running = head[ready_level];
+        head[ready_level] = link[running];
+        if (head[ready_level] == -1) tail[ready_level] = -1;
+#if ENGINE_FIFO_LEVELS > 1
+        lvl = epoch[running] == boost_epoch ? level[running] : 0;
+#endif
+#endif
+
+        int idx = running;
+        ENGINE_TASK *t = &tasks[idx];
+#if ENGINE_TO_COMPLETION
+        ENGINE_ON_DISPATCH(idx, time, 1);
+        int run_until = time + ENGINE_BURST(t);
+        (void)prev;
+#else
+        if (idx != prev) {
+            if (prev != -1 && ENGINE_REMAINING(&tasks[prev]) > 0) {
+                ENGINE_ON_PREEMPT(prev, time);
+            }
+            ENGINE_ON_DISPATCH(idx, time, ENGINE_REMAINING(t) == ENGINE_BURST(t));
+            prev = idx;
+        }
+
+        /* Run it until it finishes, its slice ends or, if preemptive,
+           the next arrival. */
+        int run_until = time + ENGINE_RUN_LENGTH(t, ENGINE_REMAINING(t), lvl);
+#endif
+#if ENGINE_PREEMPTIVE
+        if (next < count && ENGINE_ARRIVAL(&tasks[next]) < run_until) {
+            run_until = ENGINE_ARRIVAL(&tasks[next]);
+        }
+#endif
+        (void)lvl;
+        if (run_until > time) {
+            if (ENGINE_MODEL(_TRACKED)) {
+                if (last_run == -1) {
+                    stats->energy += ENGINE_MODEL(_START)(time);
+                } else if (time > last_end) {
+                    stats->energy += ENGINE_MODEL(_GAP)(time - last_end);
+                    stats->idle_periods++;
+                } else if (idx != last_run) {
+                    stats->energy += ENGINE_MODEL(_SWITCH);
+                    stats->context_switches++;
+                }
+                stats->energy += ENGINE_MODEL(_RUN)(ENGINE_BURST(t), run_until - time);
+                last_run = idx;
+                last_end = run_until;
+            }
+            ENGINE_ON_RUN(idx, time, run_until);
+        }
+#if !ENGINE_TO_COMPLETION
+        ENGINE_REMAINING(t) -= run_until - time;
+#endif
+        time = run_until;
+
+        if (ENGINE_TO_COMPLETION || ENGINE_REMAINING(t) == 0) {
+            completed++;
+            ENGINE_ON_COMPLETE(idx, time);
+#ifdef ENGINE_DEADLINE
+            if (time > ENGINE_DEADLINE(t)) stats->deadline_misses++;
+#endif
+            running = -1;
+        }
+#if defined(ENGINE_FIFO_LEVELS) && !ENGINE_IN_ORDER
+        else {
+            /* Arrivals during the slice queue ahead of the task. */
+            ENGINE_ADMIT();
+            int demoted = lvl + 1 < ENGINE_FIFO_LEVELS ? lvl + 1 : lvl;
+            (void)demoted;
+            ENGINE_ENQUEUE(idx, demoted);
+            running = -1;
+        }
+#endif
+    }
+    stats->makespan = time;
+
+#ifdef ENGINE_HEAP_KEY
+    rq_free(&rq);
+#elif !ENGINE_IN_ORDER
+    free(link);
+#if ENGINE_FIFO_LEVELS > 1
+    free(level);
+    free(epoch);
+#endif
+#endif
+}
+
+/* Reads the argmin kernel once per run, so every pop inside is a direct
+   call to the pop for that kernel. */
+static inline void ENGINE_NAME(ENGINE_TASK *tasks, int count, int quantum,
+                               ENGINE_CONTEXT *context, EngineStats *stats) {
+#ifdef ENGINE_HEAP_KEY
+    switch (argmin_kernel) {
+        case ARGMIN_SSE42:
+            ENGINE_CAT(ENGINE_NAME, _with)(tasks, count, quantum, context, stats, ARGMIN_SSE42);
+            break;
+        case ARGMIN_AVX2:
+            ENGINE_CAT(ENGINE_NAME, _with)(tasks, count, quantum, context, stats, ARGMIN_AVX2);
+            break;
+        default:
+            ENGINE_CAT(ENGINE_NAME, _with)(tasks, count, quantum, context, stats, ARGMIN_SCALAR);
+    }
+#else
+    ENGINE_CAT(ENGINE_NAME, _with)(tasks, count, quantum, context, stats, ARGMIN_SCALAR);
+#endif
+}
+
+#undef ENGINE_ADMIT
+#undef ENGINE_READY
+#undef ENGINE_ENQUEUE
+#undef ENGINE_IN_ORDER
+#undef ENGINE_TO_COMPLETION
+#undef ENGINE_NAME
+#undef ENGINE_ENERGY
+#undef ENGINE_HEAP_KEY
+#undef ENGINE_FIFO_LEVELS
+#undef ENGINE_PREEMPTIVE
+#undef ENGINE_BATCH_KEY
+#undef ENGINE_RUN_LENGTH
+#undef ENGINE_BOOST_PERIOD
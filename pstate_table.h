@@ -0,0 +1,16 @@
+#ifndef PSTATE_TABLE_H
+#define PSTATE_TABLE_H
+
+/* Default DVFS table of simulation_engine.c as {GHz, W} initializers,
+   lowest frequency first. The literals are doubles so the policy
+   engine's DVFS model reads them exactly; the simulator's float tables
+   round them as before. */
+#define DEFAULT_PSTATES \
+    {0.8, 0.9}, {1.2, 1.6}, {1.6, 2.6}, {2.0, 4.0}, {2.4, 6.0}, {2.8, 8.6}
+#define DEFAULT_PSTATE_COUNT 6
+#define DEFAULT_IDLE_POWER 0.3   /* W while no task is ready */
+
+#define DEFAULT_TOP_PSTATE_POWER \
+    (((const double[][2]){DEFAULT_PSTATES})[DEFAULT_PSTATE_COUNT - 1][1])
+
+#endif
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ready_queue.h"
+
+/* Min-heap of ready processes ordered by (key, index). Since the list is
+   sorted by arrival, the index tie-break matches the old linear scans. */
+bool rq_less(ReadyEntry a, ReadyEntry b) {
+    return a.key < b.key || (a.key == b.key && a.idx < b.idx);
+}
+
+static int64_t rq_pack(int key, int idx) {
+    return (int64_t)key * ((int64_t)1 << 32) + (uint32_t)idx;
+}
+
+static ReadyEntry rq_unpack(int64_t packed) {
+    ReadyEntry e = {(int)(packed >> 32), (int)(uint32_t)packed};
+    return e;
+}
+
+/* Children of i live at 8i+1..8i+8, so keys sits ARGMIN_WIDTH - 1 slots
+   into a 64-byte aligned block to put every sibling group on one line.
+   The slack past capacity lets the argmin kernels read a full group at
+   the end. */
+static void rq_allocate(ReadyQueue *rq, int capacity) {
+    size_t slots = (size_t)capacity + 2 * ARGMIN_WIDTH;
+    size_t bytes = (slots * sizeof(int64_t) + 63) / 64 * 64;
+    int64_t *block = aligned_alloc(64, bytes);
+    if (!block) {
+        printf("Error allocating ready queue\n");
+        exit(1);
+    }
+    int64_t *keys = block + ARGMIN_WIDTH - 1;
+    if (rq->block) {
+        memcpy(keys, rq->keys, rq->size * sizeof(int64_t));
+        free(rq->block);
+    }
+    for (size_t i = rq->size; i < slots - (ARGMIN_WIDTH - 1); i++) {
+        keys[i] = INT64_MAX;
+    }
+    rq->block = block;
+    rq->keys = keys;
+    rq->capacity = capacity;
+}
+
+void rq_init(ReadyQueue *rq, int capacity) {
+    rq->size = 0;
+    rq->block = NULL;
+    rq_allocate(rq, capacity > 0 ? capacity : 1);
+}
+
+void rq_free(ReadyQueue *rq) {
+    free(rq->block);
+    rq->block = rq->keys = NULL;
+    rq->size = rq->capacity = 0;
+}
+
+void rq_push(ReadyQueue *rq, int key, int idx) {
+    if (rq->size == rq->capacity) {
+        rq_allocate(rq, rq->capacity * 2);
+    }
+    int64_t e = rq_pack(key, idx);
+    int i = rq->size++;
+    while (i > 0) {
+        int parent = (i - 1) / ARGMIN_WIDTH;
+        if (e >= rq->keys[parent]) break;
+        rq->keys[i] = rq->keys[parent];
+        i = parent;
+    }
+    rq->keys[i] = e;
+}
+
+ReadyEntry rq_top(const ReadyQueue *rq) {
+    return rq_unpack(rq->keys[0]);
+}
+
+/* The sift-down shared by every pop. It is always inlined with a
+   constant kernel, which the compiler then inlines in turn. */
+static inline __attribute__((always_inline))
+ReadyEntry rq_pop_with(ReadyQueue *rq, int (*argmin)(const int64_t *)) {
+    int64_t top = rq->keys[0];
+    int64_t last = rq->keys[--rq->size];
+    rq->keys[rq->size] = INT64_MAX;
+    if (rq->size > 0) {
+        int i = 0;
+        for (;;) {
+            int child = ARGMIN_WIDTH * i + 1;
+            if (child >= rq->size) break;
+            child += argmin(&rq->keys[child]);
+            if (rq->keys[child] >= last) break;
+            rq->keys[i] = rq->keys[child];
+            i = child;
+        }
+        rq->keys[i] = last;
+    }
+    return rq_unpack(top);
+}
+
+ReadyEntry rq_pop_scalar(ReadyQueue *rq) {
+    return rq_pop_with(rq, argmin_scalar);
+}
+
+#ifdef ARGMIN_X86
+__attribute__((target("sse4.2")))
+ReadyEntry rq_pop_sse42(ReadyQueue *rq) {
+    return rq_pop_with(rq, argmin_sse42);
+}
+
+__attribute__((target("avx2")))
+ReadyEntry rq_pop_avx2(ReadyQueue *rq) {
+    return rq_pop_with(rq, argmin_avx2);
+}
+#else
+ReadyEntry rq_pop_sse42(ReadyQueue *rq) {
+    return rq_pop_scalar(rq);
+}
+
+ReadyEntry rq_pop_avx2(ReadyQueue *rq) {
+    return rq_pop_scalar(rq);
+}
+#endif
@@ -0,0 +1,48 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "argmin.h"
+
+typedef struct {
+    int key;
+    int idx;
+} ReadyEntry;
+
+/* 8-ary min-heap of packed (key << 32 | idx) values, so one 64-bit
+   compare orders by key then index. Each sibling group fills one
+   64-byte line and is scanned by an argmin kernel; unused slots hold
+   INT64_MAX. */
+typedef struct {
+    int64_t *keys;   /* keys[0] is the root */
+    int64_t *block;  /* aligned allocation that keys points into */
+    int size;
+    int capacity;
+} ReadyQueue;
+
+bool rq_less(ReadyEntry a, ReadyEntry b);
+void rq_init(ReadyQueue *rq, int capacity);
+void rq_free(ReadyQueue *rq);
+void rq_push(ReadyQueue *rq, int key, int idx);
+ReadyEntry rq_top(const ReadyQueue *rq);
+ReadyEntry rq_pop_scalar(ReadyQueue *rq);
+ReadyEntry rq_pop_sse42(ReadyQueue *rq);
+ReadyEntry rq_pop_avx2(ReadyQueue *rq);
+
+/* Pops with the given kernel. Callers that pass a constant get a direct
+   call to that kernel's pop; see ENGINE_NAME in policy_engine_loop.h. */
+static inline ReadyEntry rq_pop(ReadyQueue *rq, ArgminKernel kernel) {
+    switch (kernel) {
+#ifdef ARGMIN_X86
+        case ARGMIN_SSE42:
+            return rq_pop_sse42(rq);
+        case ARGMIN_AVX2:
+            return rq_pop_avx2(rq);
+#endif
+        default:
+            return rq_pop_scalar(rq);
+    }
+}
+
+#endif
@@ -1,36 +1,626 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
-typedef struct {
-    int id;             
-    float duration;     
-    float energy_cost;  
-} Task;
-
-typedef struct {
-    float frequency;   
-    float power;        
-} CPU;
-
-Task create_task(int id, float duration) {
-    Task t;
-    t.id = id;
-    t.duration = duration;
-    t.energy_cost = 0.0; 
-    return t;
-}
-
-Task* generate_workload(int num_tasks, int* seed) {
-    Task* workload = (Task*)malloc(num_tasks * sizeof(Task));
-    srand(*seed); 
+#include "simulation_engine.h"
+#include "workload.h"
+#include "pstate_table.h"
+
+#define IDLE_POWER ((float)DEFAULT_IDLE_POWER)  // W while no task is ready
+
+// Default P-state table, lowest frequency first.
+static CPU pstates[MAX_PSTATES] = {DEFAULT_PSTATES};
+static int pstate_count = DEFAULT_PSTATE_COUNT;
+
+// Default heterogeneous platform: the big cores use the table above, the
+// LITTLE cores do 60% of the work per GHz at a fraction of the power.
+static CoreType platform[MAX_CORE_TYPES] = {
+    {"big", 2, 1.0f, IDLE_POWER, {DEFAULT_PSTATES}, DEFAULT_PSTATE_COUNT},
+    {"LITTLE", 4, 0.6f, 0.05f,
+     {{0.6f, 0.15f}, {1.0f, 0.3f}, {1.4f, 0.55f}, {1.8f, 0.9f}}, 4}
+};
+static int platform_type_count = 2;
+
+int compare_pstates(const void *a, const void *b) {
+    float fa = ((const CPU *)a)->frequency, fb = ((const CPU *)b)->frequency;
+    return (fa > fb) - (fa < fb);
+}
+
+int compare_arrival(const void *a, const void *b) {
+    const Task *x = a, *y = b;
+    if (x->arrival_time != y->arrival_time) return x->arrival_time - y->arrival_time;
+    return x->id - y->id;
+}
+
+void set_pstate_table(const CPU *table, int count) {
+    if (count < 1) return;
+    if (count > MAX_PSTATES) count = MAX_PSTATES;
+    memcpy(pstates, table, count * sizeof(CPU));
+    pstate_count = count;
+    qsort(pstates, pstate_count, sizeof(CPU), compare_pstates);
+}
+
+float max_frequency(void) {
+    return pstates[pstate_count - 1].frequency;
+}
+
+// Execution time at a speed of `speed` reference GHz for work that takes
+// burst_time at the top frequency.
+int scaled_work(int burst_time, float speed) {
+    float t = burst_time * max_frequency() / speed;
+    int whole = (int)t;
+    return (t - whole > 1e-4f) ? whole + 1 : whole;
+}
+
+int scaled_time(int burst_time, float cpu_freq) {
+    return scaled_work(burst_time, cpu_freq);
+}
+
+float power_at(float cpu_freq) {
+    for (int i = 0; i < pstate_count; i++) {
+        if (pstates[i].frequency >= cpu_freq - 1e-6f) return pstates[i].power;
+    }
+    return pstates[pstate_count - 1].power;
+}
+
+float calculate_energy(int burst_time, float cpu_freq) {
+    return power_at(cpu_freq) * scaled_time(burst_time, cpu_freq);
+}
+
+// Replaces the heterogeneous platform. Returns 0, keeping the old one,
+// if the description is unusable.
+int set_platform(const CoreType *types, int count) {
+    if (count < 1 || count > MAX_CORE_TYPES) {
+        fprintf(stderr, "Error: A platform needs 1 to %d core types\n", MAX_CORE_TYPES);
+        return 0;
+    }
+    int cores = 0;
+    for (int i = 0; i < count; i++) {
+        const CoreType *ct = &types[i];
+        if (ct->cores < 1 || ct->perf <= 0 || ct->pstate_count < 1 || ct->pstate_count > MAX_PSTATES) {
+            fprintf(stderr, "Error: Invalid core type %s\n", ct->name);
+            return 0;
+        }
+        cores += ct->cores;
+    }
+    if (cores > MAX_CORES) {
+        fprintf(stderr, "Error: A platform may have at most %d cores\n", MAX_CORES);
+        return 0;
+    }
+    memcpy(platform, types, count * sizeof(CoreType));
+    platform_type_count = count;
+    for (int i = 0; i < count; i++) {
+        qsort(platform[i].pstates, platform[i].pstate_count, sizeof(CPU), compare_pstates);
+    }
+    return 1;
+}
+
+void init_simulation(SimState *state) {
+    memset(state, 0, sizeof(SimState));
+    state->cpu_freq = max_frequency();
+    state->seed = 42;
+}
+
+// Arrivals spread over MAX_TIME, durations from generate_workload(),
+// deadlines between 1.5x and 4x the burst after arrival.
+void generate_tasks(SimState *state, int num_tasks) {
+    if (num_tasks < 0) num_tasks = 0;
+    if (num_tasks > MAX_TASKS) {
+        fprintf(stderr, "Warning: %d tasks requested, simulating the first %d (MAX_TASKS)\n",
+                num_tasks, MAX_TASKS);
+        num_tasks = MAX_TASKS;
+    }
+    srand(state->seed);
+    WorkloadTask *workload = generate_workload(num_tasks, &state->seed);
+    if (!workload) return;
     for (int i = 0; i < num_tasks; i++) {
-        float duration = (rand() % 45) + 5;
-        workload[i] = create_task(i + 1, duration);
+        Task *t = &state->tasks[i];
+        memset(t, 0, sizeof(Task));
+        t->id = workload[i].id;
+        t->burst_time = (int)workload[i].duration;
+        t->arrival_time = rand() % MAX_TIME;
+        t->deadline = t->arrival_time + t->burst_time * (15 + rand() % 26) / 10;
     }
-    *seed += 1; 
-    return workload;
+    free_workload(workload);
+    // Drawn after the loop so the arrivals and deadlines above stay the
+    // same for a given seed.
+    for (int i = 0; i < num_tasks; i++) {
+        Task *t = &state->tasks[i];
+        t->actual_time = t->burst_time * (50 + rand() % 51) / 100;
+        if (t->actual_time < 1) t->actual_time = 1;
+    }
+    state->task_count = num_tasks;
+    qsort(state->tasks, state->task_count, sizeof(Task), compare_arrival);
+}
+
+// Deadline misses among tasks after `from` if the CPU frees up at `time`
+// and everything runs at the top frequency. Stops once the chain of
+// queued work drains, since nothing later can be affected.
+int misses_after(SimState *state, int from, int time) {
+    int misses = 0;
+    for (int j = from; j < state->task_count; j++) {
+        Task *t = &state->tasks[j];
+        if (t->arrival_time >= time) break;
+        time += t->burst_time;
+        if (time > t->deadline) misses++;
+    }
+    return misses;
 }
 
-int main() {
-    return 0; 
+// Runs tasks in arrival order. With use_dvfs each task gets the lowest
+// P-state that still meets its deadline without causing a miss in the
+// work queued behind it; otherwise everything runs at the top frequency.
+float simulate(SimState *state, int use_dvfs, int *misses, int *end_time) {
+    float energy = 0;
+    int time = 0;
+    *misses = 0;
+
+    for (int i = 0; i < state->task_count; i++) {
+        Task *t = &state->tasks[i];
+        if (time < t->arrival_time) {
+            energy += (t->arrival_time - time) * IDLE_POWER;
+            time = t->arrival_time;
+        }
+
+        float freq = max_frequency();
+        if (use_dvfs) {
+            int fastest = time + t->burst_time;
+            int allowed = misses_after(state, i + 1, fastest);
+            for (int p = 0; p < pstate_count - 1; p++) {
+                int finish = time + scaled_time(t->burst_time, pstates[p].frequency);
+                if (finish <= t->deadline &&
+                    misses_after(state, i + 1, finish) <= allowed) {
+                    freq = pstates[p].frequency;
+                    break;
+                }
+            }
+        }
+
+        float task_energy = calculate_energy(t->burst_time, freq);
+        time += scaled_time(t->burst_time, freq);
+        energy += task_energy;
+        if (time > t->deadline) (*misses)++;
+
+        if (use_dvfs) {
+            t->freq = freq;
+            t->energy = task_energy;
+            t->finish_time = time;
+            t->completed = 1;
+            state->cpu_freq = freq;
+        }
+    }
+
+    *end_time = time;
+    return energy;
+}
+
+// The DVFS and all-max runs are charged idle power up to the same
+// horizon so the comparison covers identical wall time.
+void run_simulation(SimState *state) {
+    int dvfs_end, baseline_end;
+    state->total_energy = simulate(state, 1, &state->deadline_misses, &dvfs_end);
+    state->baseline_energy = simulate(state, 0, &state->baseline_misses, &baseline_end);
+    if (dvfs_end > baseline_end) {
+        state->baseline_energy += (dvfs_end - baseline_end) * IDLE_POWER;
+    } else {
+        state->total_energy += (baseline_end - dvfs_end) * IDLE_POWER;
+    }
+    state->current_time = dvfs_end > baseline_end ? dvfs_end : baseline_end;
+}
+
+// Deadline misses among tasks after `from` if each goes, at the top
+// frequency, to the core where it finishes first. Like misses_after(),
+// stops once every core would be free before the next arrival.
+int platform_misses_after(SimState *state, const CoreType *types, const int *core_type,
+                          int core_count, const int *busy_until, int from) {
+    int free_at[MAX_CORES];
+    memcpy(free_at, busy_until, core_count * sizeof(int));
+    int misses = 0;
+    for (int j = from; j < state->task_count; j++) {
+        Task *t = &state->tasks[j];
+        int best_finish = -1, best_core = 0, all_free = 1;
+        for (int c = 0; c < core_count; c++) {
+            const CoreType *ct = &types[core_type[c]];
+            if (free_at[c] > t->arrival_time) all_free = 0;
+            int start = free_at[c] > t->arrival_time ? free_at[c] : t->arrival_time;
+            int finish = start + scaled_work(t->burst_time,
+                                             ct->perf * ct->pstates[ct->pstate_count - 1].frequency);
+            if (best_finish < 0 || finish < best_finish) {
+                best_finish = finish;
+                best_core = c;
+            }
+        }
+        if (all_free) break;
+        free_at[best_core] = best_finish;
+        if (best_finish > t->deadline) misses++;
+    }
+    return misses;
+}
+
+// Places each task, in arrival order, on the core and P-state that meet
+// its deadline for the least energy without causing more misses in the
+// work behind it than the fastest placement would. A short burst with
+// slack to spare fits on a slow LITTLE core; a long or urgent one only
+// makes its deadline on a big core. Tasks that cannot make it anywhere
+// go where they finish first. Idle energy is added by the caller.
+void simulate_platform(SimState *state, const CoreType *types, int type_count,
+                       int record, PlatformReport *report) {
+    int core_type[MAX_CORES], free_at[MAX_CORES];
+    int core_count = 0;
+    for (int ti = 0; ti < type_count; ti++) {
+        for (int k = 0; k < types[ti].cores; k++) {
+            core_type[core_count] = ti;
+            free_at[core_count++] = 0;
+        }
+    }
+    memset(report, 0, sizeof(PlatformReport));
+
+    for (int i = 0; i < state->task_count; i++) {
+        Task *t = &state->tasks[i];
+
+        // The fastest placement sets the fallback and the miss allowance.
+        int best_core = -1, best_finish = 0;
+        float best_energy = 0, best_freq = 0;
+        for (int c = 0; c < core_count; c++) {
+            const CoreType *ct = &types[core_type[c]];
+            const CPU *top = &ct->pstates[ct->pstate_count - 1];
+            int start = free_at[c] > t->arrival_time ? free_at[c] : t->arrival_time;
+            int finish = start + scaled_work(t->burst_time, ct->perf * top->frequency);
+            if (best_core < 0 || finish < best_finish) {
+                best_core = c;
+                best_finish = finish;
+                best_energy = top->power * (finish - start);
+                best_freq = top->frequency;
+            }
+        }
+        int saved_free = free_at[best_core];
+        free_at[best_core] = best_finish;
+        int allowed = platform_misses_after(state, types, core_type, core_count, free_at, i + 1);
+        free_at[best_core] = saved_free;
+
+        if (best_finish <= t->deadline) {
+            for (int c = 0; c < core_count; c++) {
+                const CoreType *ct = &types[core_type[c]];
+                int start = free_at[c] > t->arrival_time ? free_at[c] : t->arrival_time;
+                for (int p = 0; p < ct->pstate_count; p++) {
+                    int finish = start + scaled_work(t->burst_time, ct->perf * ct->pstates[p].frequency);
+                    float energy = ct->pstates[p].power * (finish - start);
+                    if (finish > t->deadline || energy >= best_energy) continue;
+                    int saved = free_at[c];
+                    free_at[c] = finish;
+                    int misses = platform_misses_after(state, types, core_type, core_count, free_at, i + 1);
+                    free_at[c] = saved;
+                    if (misses > allowed) continue;
+                    best_core = c;
+                    best_finish = finish;
+                    best_energy = energy;
+                    best_freq = ct->pstates[p].frequency;
+                }
+            }
+        }
+
+        int start = free_at[best_core] > t->arrival_time ? free_at[best_core] : t->arrival_time;
+        CoreTypeReport *tr = &report->types[core_type[best_core]];
+        free_at[best_core] = best_finish;
+        tr->tasks++;
+        tr->busy_time += best_finish - start;
+        tr->energy += best_energy;
+        report->energy += best_energy;
+        if (best_finish > t->deadline) {
+            tr->misses++;
+            report->misses++;
+        }
+        if (best_finish > report->end_time) report->end_time = best_finish;
+
+        if (record) {
+            t->core = best_core;
+            t->freq = best_freq;
+            t->energy = best_energy;
+            t->finish_time = best_finish;
+            t->completed = 1;
+        }
+    }
+}
+
+// Charges every core idle power for the time it was not busy up to `horizon`.
+void add_idle_energy(PlatformReport *report, const CoreType *types, int type_count, int horizon) {
+    for (int ti = 0; ti < type_count; ti++) {
+        CoreTypeReport *tr = &report->types[ti];
+        float idle = (types[ti].cores * horizon - tr->busy_time) * types[ti].idle_power;
+        tr->energy += idle;
+        report->energy += idle;
+    }
+}
+
+// The baseline has as many cores as the platform, all of its fastest type.
+CoreType baseline_type(void) {
+    int fastest = 0, cores = 0;
+    for (int i = 0; i < platform_type_count; i++) {
+        const CoreType *ct = &platform[i], *best = &platform[fastest];
+        if (ct->perf * ct->pstates[ct->pstate_count - 1].frequency >
+            best->perf * best->pstates[best->pstate_count - 1].frequency) fastest = i;
+        cores += ct->cores;
+    }
+    CoreType baseline = platform[fastest];
+    baseline.cores = cores;
+    return baseline;
+}
+
+void run_hetero_simulation(SimState *state) {
+    CoreType baseline = baseline_type();
+    simulate_platform(state, platform, platform_type_count, 1, &state->hetero);
+    simulate_platform(state, &baseline, 1, 0, &state->hetero_baseline);
+    int horizon = state->hetero.end_time > state->hetero_baseline.end_time ?
+                  state->hetero.end_time : state->hetero_baseline.end_time;
+    add_idle_energy(&state->hetero, platform, platform_type_count, horizon);
+    add_idle_energy(&state->hetero_baseline, &baseline, 1, horizon);
+    state->current_time = horizon;
+}
+
+// Binary min-heap of task indices ordered by deadline, then id.
+static int edf_before(const SimState *state, int a, int b) {
+    const Task *x = &state->tasks[a], *y = &state->tasks[b];
+    if (x->deadline != y->deadline) return x->deadline < y->deadline;
+    return x->id < y->id;
+}
+
+static void edf_push(const SimState *state, int *heap, int *size, int task) {
+    int i = (*size)++;
+    while (i > 0 && edf_before(state, task, heap[(i - 1) / 2])) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = task;
+}
+
+static int edf_pop(const SimState *state, int *heap, int *size) {
+    int top = heap[0];
+    int last = heap[--(*size)];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= *size) break;
+        if (child + 1 < *size && edf_before(state, heap[child + 1], heap[child])) child++;
+        if (!edf_before(state, heap[child], last)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (*size > 0) heap[i] = last;
+    return top;
+}
+
+// Lowest P-state whose share of the top frequency covers `density`.
+float frequency_for(float density) {
+    for (int p = 0; p < pstate_count; p++) {
+        if (pstates[p].frequency >= density * max_frequency() - 1e-4f) return pstates[p].frequency;
+    }
+    return max_frequency();
+}
+
+// Smallest share of the top frequency at which every ready task still
+// meets its deadline if each needs its whole burst: the largest ratio of
+// worst-case work due by a deadline to the time left until it.
+float demand_density(const SimState *state, const int *ready, int ready_count,
+                     const float *done, double time) {
+    int heap[MAX_TASKS], size = ready_count;
+    memcpy(heap, ready, ready_count * sizeof(int));
+    float work = 0, demand = 0;
+    while (size > 0) {
+        int k = edf_pop(state, heap, &size);
+        const Task *t = &state->tasks[k];
+        work += t->burst_time - done[k];
+        if (t->deadline <= time + 1e-6) return 2.0f;
+        float d = work / (float)(t->deadline - time);
+        if (d > demand) demand = d;
+    }
+    return demand;
+}
+
+// Preemptive EDF driven by three events: an arrival, the running task
+// finishing, and (EDF_STATIC only) a finished task's deadline passing.
+// The frequency only changes at an event. Each task adds its worst-case
+// density burst / (deadline - arrival) while it counts towards the load,
+// and the CPU runs at the lowest P-state covering both that total and
+// the worst-case demand of the tasks already ready. Tasks usually need
+// less than their burst, and EDF_RECLAIM gives the unused share back as
+// soon as they finish rather than at their deadline.
+float simulate_edf(SimState *state, EdfPolicy policy, int *misses, int *end_time) {
+    int ready[MAX_TASKS], expiring[MAX_TASKS];
+    int ready_count = 0, expiring_count = 0, next = 0;
+    float remaining[MAX_TASKS], done[MAX_TASKS], running[MAX_TASKS], task_energy[MAX_TASKS];
+    float density = 0, energy = 0;
+    double time = 0;
+    *misses = 0;
+
+    for (int i = 0; i < state->task_count; i++) {
+        remaining[i] = state->tasks[i].actual_time;
+        done[i] = 0;
+        running[i] = 0;
+        task_energy[i] = 0;
+    }
+
+    for (;;) {
+        while (next < state->task_count && state->tasks[next].arrival_time <= time + 1e-6) {
+            Task *t = &state->tasks[next];
+            density += (float)t->burst_time / (t->deadline - t->arrival_time);
+            edf_push(state, ready, &ready_count, next++);
+        }
+        while (expiring_count > 0 && state->tasks[expiring[0]].deadline <= time + 1e-6) {
+            Task *t = &state->tasks[edf_pop(state, expiring, &expiring_count)];
+            density -= (float)t->burst_time / (t->deadline - t->arrival_time);
+        }
+
+        double event = -1;
+        if (next < state->task_count) event = state->tasks[next].arrival_time;
+        if (expiring_count > 0 && (event < 0 || state->tasks[expiring[0]].deadline < event)) {
+            event = state->tasks[expiring[0]].deadline;
+        }
+
+        if (ready_count == 0) {
+            if (event < 0) break;
+            energy += (event - time) * IDLE_POWER;
+            time = event;
+            continue;
+        }
+
+        int j = ready[0];
+        float freq = max_frequency();
+        if (policy != EDF_MAX_FREQ) {
+            float demand = demand_density(state, ready, ready_count, done, time);
+            freq = frequency_for(demand > density ? demand : density);
+        }
+        double finish = time + remaining[j] * max_frequency() / freq;
+        if (event < 0 || finish < event) event = finish;
+        float step = event - time;
+        energy += power_at(freq) * step;
+        task_energy[j] += power_at(freq) * step;
+        running[j] += step;
+        remaining[j] -= step * freq / max_frequency();
+        done[j] += step * freq / max_frequency();
+        time = event;
+
+        if (event == finish) {
+            Task *t = &state->tasks[edf_pop(state, ready, &ready_count)];
+            if (policy == EDF_STATIC && t->deadline > time + 1e-6) {
+                edf_push(state, expiring, &expiring_count, j);
+            } else {
+                density -= (float)t->burst_time / (t->deadline - t->arrival_time);
+            }
+            int finished = (int)time;
+            if (time - finished > 1e-4) finished++;
+            if (finished > t->deadline) (*misses)++;
+            if (policy == EDF_RECLAIM) {
+                t->freq = t->actual_time * max_frequency() / running[j];
+                t->energy = task_energy[j];
+                t->finish_time = finished;
+                t->completed = 1;
+            }
+        }
+    }
+
+    *end_time = (int)time;
+    if (time - *end_time > 1e-4) (*end_time)++;
+    return energy;
+}
+
+// As in run_simulation(), every policy is charged idle power up to the
+// same horizon.
+void run_edf_simulation(SimState *state) {
+    int end_time[EDF_POLICIES], horizon = 0;
+    for (int p = 0; p < EDF_POLICIES; p++) {
+        state->edf_energy[p] = simulate_edf(state, p, &state->edf_misses[p], &end_time[p]);
+        if (end_time[p] > horizon) horizon = end_time[p];
+    }
+    for (int p = 0; p < EDF_POLICIES; p++) {
+        state->edf_energy[p] += (horizon - end_time[p]) * IDLE_POWER;
+    }
+    state->current_time = horizon;
+}
+
+void print_results(SimState *state) {
+    printf("\n=== DVFS Simulation Results ===\n");
+    printf("Task | Arrival | Burst | Deadline | Freq (GHz) | Finish | Energy (mJ) | Deadline\n");
+    for (int i = 0; i < state->task_count; i++) {
+        Task *t = &state->tasks[i];
+        printf("%4d | %7d | %5d | %8d | %10.1f | %6d | %11.1f | %s\n",
+               t->id, t->arrival_time, t->burst_time, t->deadline, t->freq,
+               t->finish_time, t->energy, t->finish_time <= t->deadline ? "met" : "MISSED");
+    }
+
+    float saved = state->baseline_energy - state->total_energy;
+    printf("\nEnergy with DVFS: %.1f mJ (%d deadline misses)\n",
+           state->total_energy, state->deadline_misses);
+    printf("Energy at max frequency: %.1f mJ (%d deadline misses)\n",
+           state->baseline_energy, state->baseline_misses);
+    printf("Energy saved: %.1f mJ (%.1f%%)\n", saved,
+           state->baseline_energy > 0 ? 100.0f * saved / state->baseline_energy : 0.0f);
+}
+
+void print_hetero_results(SimState *state) {
+    const char *core_name[MAX_CORES];
+    int core_index[MAX_CORES], core_count = 0;
+    for (int ti = 0; ti < platform_type_count; ti++) {
+        for (int k = 0; k < platform[ti].cores; k++) {
+            core_name[core_count] = platform[ti].name;
+            core_index[core_count++] = k;
+        }
+    }
+
+    printf("\n=== Heterogeneous Platform Results ===\n");
+    printf("Task | Arrival | Burst | Deadline | Core      | Freq (GHz) | Finish | Energy (mJ) | Deadline\n");
+    for (int i = 0; i < state->task_count; i++) {
+        Task *t = &state->tasks[i];
+        printf("%4d | %7d | %5d | %8d | %-6s %2d | %10.1f | %6d | %11.1f | %s\n",
+               t->id, t->arrival_time, t->burst_time, t->deadline, core_name[t->core],
+               core_index[t->core], t->freq, t->finish_time, t->energy,
+               t->finish_time <= t->deadline ? "met" : "MISSED");
+    }
+
+    printf("\nCore Type | Cores | Tasks | Busy Time | Misses | Energy (mJ)\n");
+    for (int ti = 0; ti < platform_type_count; ti++) {
+        CoreTypeReport *tr = &state->hetero.types[ti];
+        printf("%-9s | %5d | %5d | %9d | %6d | %11.1f\n", platform[ti].name,
+               platform[ti].cores, tr->tasks, tr->busy_time, tr->misses, tr->energy);
+    }
+
+    CoreType baseline = baseline_type();
+    float saved = state->hetero_baseline.energy - state->hetero.energy;
+    printf("\nEnergy on the heterogeneous platform: %.1f mJ (%d deadline misses)\n",
+           state->hetero.energy, state->hetero.misses);
+    printf("Energy on %d %s cores: %.1f mJ (%d deadline misses)\n", baseline.cores,
+           baseline.name, state->hetero_baseline.energy, state->hetero_baseline.misses);
+    printf("Energy saved: %.1f mJ (%.1f%%)\n", saved,
+           state->hetero_baseline.energy > 0 ? 100.0f * saved / state->hetero_baseline.energy : 0.0f);
+}
+
+void print_edf_results(SimState *state) {
+    static const char *names[EDF_POLICIES] = {
+        "EDF at max frequency", "EDF, static slack", "EDF, slack reclamation"
+    };
+
+    printf("\n=== EDF Simulation Results (slack reclamation) ===\n");
+    printf("Task | Arrival | Burst | Actual | Deadline | Avg Freq (GHz) | Finish | Energy (mJ) | Deadline\n");
+    for (int i = 0; i < state->task_count; i++) {
+        Task *t = &state->tasks[i];
+        printf("%4d | %7d | %5d | %6d | %8d | %14.2f | %6d | %11.1f | %s\n",
+               t->id, t->arrival_time, t->burst_time, t->actual_time, t->deadline, t->freq,
+               t->finish_time, t->energy, t->finish_time <= t->deadline ? "met" : "MISSED");
+    }
+
+    printf("\nPolicy                 | Energy (mJ) | Misses | Miss Ratio\n");
+    for (int p = 0; p < EDF_POLICIES; p++) {
+        printf("%-22s | %11.1f | %6d | %9.1f%%\n", names[p], state->edf_energy[p],
+               state->edf_misses[p],
+               state->task_count > 0 ? 100.0f * state->edf_misses[p] / state->task_count : 0.0f);
+    }
+
+    float saved = state->edf_energy[EDF_MAX_FREQ] - state->edf_energy[EDF_RECLAIM];
+    printf("\nEnergy saved by slack reclamation: %.1f mJ (%.1f%%)\n", saved,
+           state->edf_energy[EDF_MAX_FREQ] > 0 ? 100.0f * saved / state->edf_energy[EDF_MAX_FREQ] : 0.0f);
+}
+
+int main(int argc, char *argv[]) {
+    SimState state;
+    int hetero = argc > 1 && strcmp(argv[1], "hetero") == 0;
+    int edf = argc > 1 && strcmp(argv[1], "edf") == 0;
+    if (hetero || edf) {
+        argc--;
+        argv++;
+    }
+    int num_tasks = argc > 1 ? atoi(argv[1]) : 20;
+
+    init_simulation(&state);
+    if (argc > 2) state.seed = atoi(argv[2]);
+    generate_tasks(&state, num_tasks);
+    if (hetero) {
+        run_hetero_simulation(&state);
+        print_hetero_results(&state);
+    } else if (edf) {
+        run_edf_simulation(&state);
+        print_edf_results(&state);
+    } else {
+        run_simulation(&state);
+        print_results(&state);
+    }
+    return 0;
 }
@@ -3,31 +3,95 @@
 
 #define MAX_TASKS 100
 #define MAX_TIME 1000 // Simulation time in milliseconds
+#define MAX_PSTATES 16
+#define MAX_CORE_TYPES 4
+#define MAX_CORES 32
 
 
 typedef struct {
     int id;           
     int arrival_time; 
-    int burst_time;   
+    int burst_time;   // at the highest P-state frequency
+    int actual_time;  // work it really needs, at most burst_time (EDF only)
     int deadline;     
     int completed;    
     float energy;     
+    float freq;       // frequency the task ran at
+    int finish_time;  
+    int core;         // core it ran on in the heterogeneous run
 } Task;
 
 
+typedef struct {
+    float frequency;  // GHz
+    float power;      // W while running at this frequency
+} CPU;
+
+
+// One kind of core on a heterogeneous platform. Work per GHz is scaled
+// by perf relative to the reference core (perf 1.0 at the top frequency
+// of the single-core P-state table runs a task in its burst_time).
+typedef struct {
+    const char *name;
+    int cores;
+    float perf;
+    float idle_power;            // W while the core has nothing to run
+    CPU pstates[MAX_PSTATES];    // lowest frequency first
+    int pstate_count;
+} CoreType;
+
+
+typedef struct {
+    int tasks;
+    int busy_time;
+    int misses;
+    float energy;     // busy plus idle energy of all cores of the type
+} CoreTypeReport;
+
+
+typedef struct {
+    float energy;
+    int misses;
+    int end_time;
+    CoreTypeReport types[MAX_CORE_TYPES];
+} PlatformReport;
+
+
+typedef enum {
+    EDF_MAX_FREQ,   // always at the top frequency
+    EDF_STATIC,     // frequency from the worst-case density of unexpired tasks
+    EDF_RECLAIM,    // as EDF_STATIC, but a finished task's density is released at once
+    EDF_POLICIES
+} EdfPolicy;
+
+
 typedef struct {
     Task tasks[MAX_TASKS];
     int task_count;
     float total_energy; 
     int current_time;   
     float cpu_freq;     
+    int deadline_misses;
+    float baseline_energy;  // same tasks, always at the highest frequency
+    int baseline_misses;
+    int seed;
+    PlatformReport hetero;           // the platform set by set_platform()
+    PlatformReport hetero_baseline;  // same core count, all of the fastest type
+    float edf_energy[EDF_POLICIES];
+    int edf_misses[EDF_POLICIES];
 } SimState;
 
 
 void init_simulation(SimState *state);
+void set_pstate_table(const CPU *table, int count);
+int set_platform(const CoreType *types, int count);
 void generate_tasks(SimState *state, int num_tasks);
 void run_simulation(SimState *state);
+void run_hetero_simulation(SimState *state);
+void run_edf_simulation(SimState *state);
 float calculate_energy(int burst_time, float cpu_freq);
 void print_results(SimState *state);
+void print_hetero_results(SimState *state);
+void print_edf_results(SimState *state);
 
 #endif
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "submit_queue.h"
+
+/* Capacity is rounded up to a power of two so slot lookup is a mask. */
+int submit_queue_init(SubmitQueue *q, size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    q->slots = malloc(size * sizeof(SubmitSlot));
+    if (!q->slots) {
+        fprintf(stderr, "Error: Could not allocate submission queue\n");
+        return 0;
+    }
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&q->slots[i].sequence, i);
+    }
+    q->mask = size - 1;
+    atomic_init(&q->tail, 0);
+    q->head = 0;
+    return 1;
+}
+
+void submit_queue_free(SubmitQueue *q) {
+    free(q->slots);
+    q->slots = NULL;
+}
+
+/* Returns 0 if the queue is full; the caller decides whether to retry. */
+int submit_queue_push(SubmitQueue *q, const TaskSubmission *task) {
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    for (;;) {
+        SubmitSlot *slot = &q->slots[pos & q->mask];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (seq == pos) {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                slot->task = *task;
+                atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        } else if (seq < pos) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+}
+
+/* Moves up to max published tasks into the scheduler, stopping at the
+   first slot a producer has claimed but not yet filled. Returns the
+   number of tasks moved. */
+int submit_queue_drain(SubmitQueue *q, Scheduler *sched, int max) {
+    int moved = 0;
+    while (moved < max) {
+        SubmitSlot *slot = &q->slots[q->head & q->mask];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (seq != q->head + 1) break;
+        TaskSubmission task = slot->task;
+        atomic_store_explicit(&slot->sequence, q->head + q->mask + 1, memory_order_release);
+        q->head++;
+        add_task(sched, task.id, task.exec_time, task.arrival_time, task.priority);
+        moved++;
+    }
+    return moved;
+}
@@ -0,0 +1,46 @@
+#ifndef SUBMIT_QUEUE_H
+#define SUBMIT_QUEUE_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "energy_scheduler.h"
+
+/*
+ * Bounded lock-free submission queue for the energy scheduler.
+ *
+ * Any number of producer threads may call submit_queue_push() at once;
+ * only the scheduling thread may call submit_queue_drain(), which moves
+ * the queued tasks into the Scheduler with add_task(). Each slot carries
+ * a sequence number: a producer claims a slot by advancing the shared
+ * tail with a compare-and-swap, fills it, then publishes it by bumping
+ * the slot's sequence. Producers never wait on each other, only on the
+ * consumer when the ring is full.
+ */
+
+#define SUBMIT_CACHE_LINE 64
+
+typedef struct {
+    int id;
+    int exec_time;
+    int arrival_time;
+    int priority;
+} TaskSubmission;
+
+typedef struct {
+    atomic_size_t sequence;
+    TaskSubmission task;
+} SubmitSlot;
+
+typedef struct {
+    SubmitSlot *slots;
+    size_t mask;
+    _Alignas(SUBMIT_CACHE_LINE) atomic_size_t tail;   /* shared by producers */
+    _Alignas(SUBMIT_CACHE_LINE) size_t head;          /* consumer only */
+} SubmitQueue;
+
+int submit_queue_init(SubmitQueue *q, size_t capacity);
+void submit_queue_free(SubmitQueue *q);
+int submit_queue_push(SubmitQueue *q, const TaskSubmission *task);
+int submit_queue_drain(SubmitQueue *q, Scheduler *sched, int max);
+
+#endif
@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timing_wheel.h"
+
+static int slot_of(int time, int level) {
+    return ((unsigned)time >> (level * WHEEL_SLOT_BITS)) & (WHEEL_SLOTS - 1);
+}
+
+/* First occupied slot at or after `from` on a level, or -1. */
+static int first_occupied(const uint64_t *bits, int from) {
+    for (int word = from / 64; word < WHEEL_SLOTS / 64; word++) {
+        uint64_t mask = bits[word];
+        if (word == from / 64) mask &= ~0ULL << (from % 64);
+        if (mask) return word * 64 + __builtin_ctzll(mask);
+    }
+    return -1;
+}
+
+static void file_item(TimingWheel *w, int item) {
+    int time = w->time[item] > w->now ? w->time[item] : w->now;
+    unsigned diff = (unsigned)time ^ (unsigned)w->now;
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && (diff >> ((level + 1) * WHEEL_SLOT_BITS)) != 0) level++;
+    int slot = slot_of(time, level);
+    w->next[item] = w->head[level][slot];
+    w->head[level][slot] = item;
+    w->occupied[level][slot / 64] |= 1ULL << (slot % 64);
+}
+
+static int take_slot(TimingWheel *w, int level, int slot) {
+    int head = w->head[level][slot];
+    w->head[level][slot] = -1;
+    w->occupied[level][slot / 64] &= ~(1ULL << (slot % 64));
+    return head;
+}
+
+/* Moves the wheel's time forward. Only the slot that now contains the
+   current time can hold items filed too high, so each level cascades
+   at most that one slot, highest level first. */
+static void set_now(TimingWheel *w, int time) {
+    int old = w->now;
+    w->now = time;
+    for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+        int shift = level * WHEEL_SLOT_BITS;
+        if (((unsigned)time >> shift) == ((unsigned)old >> shift)) continue;
+        int item = take_slot(w, level, slot_of(time, level));
+        while (item != -1) {
+            int next = w->next[item];
+            file_item(w, item);
+            item = next;
+        }
+    }
+}
+
+void wheel_init(TimingWheel *w) {
+    memset(w, 0, sizeof(TimingWheel));
+    memset(w->head, -1, sizeof(w->head));
+}
+
+void wheel_free(TimingWheel *w) {
+    free(w->next);
+    free(w->time);
+    wheel_init(w);
+}
+
+int wheel_reserve(TimingWheel *w, int items) {
+    if (items <= w->capacity) return 1;
+    int *next = realloc(w->next, items * sizeof(int));
+    if (next) w->next = next;
+    int *time = realloc(w->time, items * sizeof(int));
+    if (time) w->time = time;
+    if (!next || !time) {
+        fprintf(stderr, "Error: Could not grow timing wheel\n");
+        return 0;
+    }
+    w->capacity = items;
+    return 1;
+}
+
+/* Items due at or before the wheel's time are released by the next
+   wheel_advance() call. */
+void wheel_insert(TimingWheel *w, int item, int time) {
+    w->time[item] = time;
+    file_item(w, item);
+    w->count++;
+}
+
+/* Earliest due time, or -1 if the wheel is empty. Only a slot above
+   level 0 has to be scanned for its minimum, and it is cascaded as
+   soon as the wheel reaches that time. */
+int wheel_next_time(const TimingWheel *w) {
+    if (w->count == 0) return -1;
+    int slot = first_occupied(w->occupied[0], slot_of(w->now, 0));
+    if (slot >= 0) {
+        return (int)(((unsigned)w->now & ~(unsigned)(WHEEL_SLOTS - 1)) | (unsigned)slot);
+    }
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+        int from = slot_of(w->now, level) + 1;
+        slot = from < WHEEL_SLOTS ? first_occupied(w->occupied[level], from) : -1;
+        if (slot < 0) continue;
+        int earliest = -1;
+        for (int item = w->head[level][slot]; item != -1; item = w->next[item]) {
+            if (earliest == -1 || w->time[item] < earliest) earliest = w->time[item];
+        }
+        return earliest;
+    }
+    return -1;
+}
+
+/* Releases every item due at or before `time` and returns them as a
+   list threaded through w->next (-1 terminated). The wheel's time never
+   moves backwards. */
+int wheel_advance(TimingWheel *w, int time) {
+    int released = -1;
+    for (;;) {
+        int due = wheel_next_time(w);
+        if (due < 0 || due > time) break;
+        if (due > w->now) set_now(w, due);
+        int item = take_slot(w, 0, slot_of(due, 0));
+        while (item != -1) {
+            int next = w->next[item];
+            w->next[item] = released;
+            released = item;
+            w->count--;
+            item = next;
+        }
+    }
+    if (time > w->now) set_now(w, time);
+    return released;
+}
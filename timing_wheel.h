@@ -0,0 +1,40 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <stdint.h>
+
+/*
+ * Hierarchical timing wheel for future arrival events.
+ *
+ * Items are small integers (task indices) keyed by a non-negative time.
+ * Level L has 256 slots, each covering 256^L time units, and an item is
+ * filed on the lowest level whose slot still separates it from the
+ * wheel's current time. An occupancy bitmap per level finds the next
+ * non-empty slot in a few word operations, so an idle gap of any length
+ * costs the same as one of a single tick. Items in a higher-level slot
+ * cascade down once the wheel's time enters that slot, at most once
+ * per level.
+ */
+
+#define WHEEL_LEVELS 4
+#define WHEEL_SLOT_BITS 8
+#define WHEEL_SLOTS (1 << WHEEL_SLOT_BITS)
+
+typedef struct {
+    int head[WHEEL_LEVELS][WHEEL_SLOTS];   /* -1 when the slot is empty */
+    uint64_t occupied[WHEEL_LEVELS][WHEEL_SLOTS / 64];
+    int *next;      /* per item: next item in the same slot */
+    int *time;      /* per item: time it is due */
+    int capacity;
+    int count;
+    int now;
+} TimingWheel;
+
+void wheel_init(TimingWheel *w);
+void wheel_free(TimingWheel *w);
+int wheel_reserve(TimingWheel *w, int items);
+void wheel_insert(TimingWheel *w, int item, int time);
+int wheel_next_time(const TimingWheel *w);
+int wheel_advance(TimingWheel *w, int time);
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "trace_format.h"
+
+static const size_t workload_widths[WORKLOAD_COLUMNS] = {
+    sizeof(int32_t), sizeof(int32_t), sizeof(int32_t), TRACE_NAME_WIDTH
+};
+
+static const size_t results_widths[RESULTS_COLUMNS] = {
+    sizeof(int32_t), sizeof(float), sizeof(float), sizeof(float)
+};
+
+static const size_t *column_widths(uint32_t kind, uint32_t *count) {
+    switch (kind) {
+        case TRACE_WORKLOAD:
+            *count = WORKLOAD_COLUMNS;
+            return workload_widths;
+        case TRACE_RESULTS:
+            *count = RESULTS_COLUMNS;
+            return results_widths;
+        default:
+            *count = 0;
+            return NULL;
+    }
+}
+
+static void layout_columns(TraceHeader *h, const size_t *widths) {
+    uint64_t offset = sizeof(TraceHeader);
+    for (uint32_t c = 0; c < h->column_count; c++) {
+        offset = (offset + 7) & ~(uint64_t)7;
+        h->column_offset[c] = offset;
+        offset += h->row_count * widths[c];
+    }
+}
+
+static int trace_write(const char *filename, TraceKind kind, size_t rows, const void *columns[]) {
+    TraceHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, TRACE_MAGIC, 4);
+    h.version = TRACE_VERSION;
+    h.kind = kind;
+    h.row_count = rows;
+    const size_t *widths = column_widths(kind, &h.column_count);
+    layout_columns(&h, widths);
+
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        fprintf(stderr, "Error: Could not open %s for writing\n", filename);
+        return 0;
+    }
+    setvbuf(fp, NULL, _IOFBF, 1 << 20);
+
+    static const char padding[8] = {0};
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+    uint64_t written = sizeof(h);
+    for (uint32_t c = 0; ok && c < h.column_count; c++) {
+        if (h.column_offset[c] > written) {
+            ok = fwrite(padding, h.column_offset[c] - written, 1, fp) == 1;
+        }
+        if (ok && rows > 0) {
+            ok = fwrite(columns[c], widths[c], rows, fp) == rows;
+        }
+        written = h.column_offset[c] + rows * widths[c];
+    }
+
+    if (fclose(fp) != 0 || !ok) {
+        fprintf(stderr, "Error: Failed writing %s\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+int trace_write_workload(const char *filename, size_t rows,
+                         const int32_t *arrival, const int32_t *burst,
+                         const int32_t *priority, const char (*names)[TRACE_NAME_WIDTH]) {
+    const void *columns[WORKLOAD_COLUMNS] = {arrival, burst, priority, names};
+    return trace_write(filename, TRACE_WORKLOAD, rows, columns);
+}
+
+int trace_write_results(const char *filename, size_t rows,
+                        const int32_t *pid, const float *energy,
+                        const float *exec_time, const float *wait_time) {
+    const void *columns[RESULTS_COLUMNS] = {pid, energy, exec_time, wait_time};
+    return trace_write(filename, TRACE_RESULTS, rows, columns);
+}
+
+int trace_is_binary(const char *filename) {
+    char magic[4];
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) return 0;
+    int is_binary = fread(magic, 1, 4, fp) == 4 && memcmp(magic, TRACE_MAGIC, 4) == 0;
+    fclose(fp);
+    return is_binary;
+}
+
+/* Maps the file read-only and checks the header against the expected
+   kind, so trace_column() pointers can be used directly as arrays. */
+int trace_open(TraceFile *tf, const char *filename, TraceKind kind) {
+    memset(tf, 0, sizeof(TraceFile));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Could not open %s\n", filename);
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        fprintf(stderr, "Error: %s is not a trace file\n", filename);
+        close(fd);
+        return 0;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Error: Could not map %s\n", filename);
+        return 0;
+    }
+
+    const TraceHeader *h = base;
+    uint32_t expected_columns;
+    const size_t *widths = column_widths(kind, &expected_columns);
+    const char *problem = NULL;
+    if (memcmp(h->magic, TRACE_MAGIC, 4) != 0) {
+        problem = "bad magic";
+    } else if (h->version != TRACE_VERSION) {
+        problem = "unsupported version";
+    } else if (h->kind != (uint32_t)kind || h->column_count != expected_columns) {
+        problem = "unexpected trace kind";
+    } else {
+        for (uint32_t c = 0; c < h->column_count; c++) {
+            if (h->column_offset[c] % 8 != 0 ||
+                h->column_offset[c] > (uint64_t)st.st_size ||
+                h->row_count > ((uint64_t)st.st_size - h->column_offset[c]) / widths[c]) {
+                problem = "truncated column data";
+                break;
+            }
+        }
+    }
+    if (problem) {
+        fprintf(stderr, "Error: %s: %s\n", filename, problem);
+        munmap(base, st.st_size);
+        return 0;
+    }
+
+    madvise(base, st.st_size, MADV_SEQUENTIAL);
+    tf->base = base;
+    tf->size = st.st_size;
+    tf->header = h;
+    return 1;
+}
+
+const void *trace_column(const TraceFile *tf, int column) {
+    return (const char *)tf->base + tf->header->column_offset[column];
+}
+
+void trace_close(TraceFile *tf) {
+    if (tf->base) {
+        munmap(tf->base, tf->size);
+    }
+    memset(tf, 0, sizeof(TraceFile));
+}
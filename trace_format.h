@@ -0,0 +1,71 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Binary columnar trace format shared by CPU.c (workloads) and
+ * visualization.c (schedule results).
+ *
+ * Layout: a fixed 64-byte TraceHeader followed by one contiguous column
+ * per field, each starting on an 8-byte boundary at the offset recorded
+ * in the header. All integers and floats are stored in host byte order
+ * (little-endian on every platform we run on), so a mapped file can be
+ * read in place without any decoding.
+ */
+
+#define TRACE_MAGIC "ESTR"
+#define TRACE_VERSION 1
+#define TRACE_MAX_COLUMNS 5
+#define TRACE_NAME_WIDTH 16
+
+typedef enum {
+    TRACE_WORKLOAD = 1,   /* arrival, burst, priority (int32), name (char[16]) */
+    TRACE_RESULTS = 2     /* pid (int32), energy, exec_time, wait_time (float) */
+} TraceKind;
+
+enum {
+    WORKLOAD_ARRIVAL = 0,
+    WORKLOAD_BURST = 1,
+    WORKLOAD_PRIORITY = 2,
+    WORKLOAD_NAME = 3,
+    WORKLOAD_COLUMNS = 4
+};
+
+enum {
+    RESULTS_PID = 0,
+    RESULTS_ENERGY = 1,
+    RESULTS_EXEC_TIME = 2,
+    RESULTS_WAIT_TIME = 3,
+    RESULTS_COLUMNS = 4
+};
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t kind;
+    uint32_t column_count;
+    uint64_t row_count;
+    uint64_t column_offset[TRACE_MAX_COLUMNS];
+} TraceHeader;
+
+typedef struct {
+    void *base;
+    size_t size;
+    const TraceHeader *header;
+} TraceFile;
+
+int trace_is_binary(const char *filename);
+int trace_open(TraceFile *tf, const char *filename, TraceKind kind);
+const void *trace_column(const TraceFile *tf, int column);
+void trace_close(TraceFile *tf);
+
+int trace_write_workload(const char *filename, size_t rows,
+                         const int32_t *arrival, const int32_t *burst,
+                         const int32_t *priority, const char (*names)[TRACE_NAME_WIDTH]);
+int trace_write_results(const char *filename, size_t rows,
+                        const int32_t *pid, const float *energy,
+                        const float *exec_time, const float *wait_time);
+
+#endif
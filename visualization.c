@@ -1,42 +1,182 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "visualization.h"
+#include "trace_format.h"
 
-void load_results(ProcessData processes[], int *num_processes) {
-  
-    *num_processes = 5;
-    processes[0] = (ProcessData){1, 10.5, 5.0, 2.0};
-    processes[1] = (ProcessData){2, 15.0, 7.0, 3.5};
-    processes[2] = (ProcessData){3, 8.0, 4.0, 1.5};
-    processes[3] = (ProcessData){4, 12.0, 6.0, 2.8};
-    processes[4] = (ProcessData){5, 9.5, 5.5, 2.2};
+/* Shown when no results file is given. */
+static const ProcessData sample_results[] = {
+    {1, 10.5, 5.0, 2.0},
+    {2, 15.0, 7.0, 3.5},
+    {3, 8.0, 4.0, 1.5},
+    {4, 12.0, 6.0, 2.8},
+    {5, 9.5, 5.5, 2.2}
+};
+
+static double sketch_gamma(void) {
+    return (1 + SKETCH_ACCURACY) / (1 - SKETCH_ACCURACY);
 }
 
-void display_bar_chart(ProcessData processes[], int num_processes) {
-    printf("\n=== Energy Consumption Bar Chart ===\n");
-    for (int i = 0; i < num_processes; i++) {
-        printf("P%d |", processes[i].pid);
-        int bars = (int)(processes[i].energy / 2); // Scale for display
+/* Offset that puts SKETCH_MIN_VALUE in bucket 0. */
+static int sketch_offset(void) {
+    return (int)-floor(log(SKETCH_MIN_VALUE) / log(sketch_gamma()));
+}
+
+/* Midpoint (in relative terms) of bucket i, the value reported for it. */
+static double sketch_bucket_value(int i) {
+    double gamma = sketch_gamma();
+    return 2 * pow(gamma, i - sketch_offset()) / (gamma + 1);
+}
+
+void sketch_init(QuantileSketch *s) {
+    memset(s, 0, sizeof(QuantileSketch));
+}
+
+void sketch_add(QuantileSketch *s, double value) {
+    if (s->count == 0 || value < s->min) s->min = value;
+    if (s->count == 0 || value > s->max) s->max = value;
+    s->count++;
+    s->sum += value;
+    if (value <= SKETCH_MIN_VALUE) {
+        s->zero_count++;
+        return;
+    }
+    int i = (int)ceil(log(value) / log(sketch_gamma())) + sketch_offset();
+    if (i < 0) i = 0;
+    if (i >= SKETCH_BUCKETS) i = SKETCH_BUCKETS - 1;
+    s->counts[i]++;
+}
+
+double sketch_quantile(const QuantileSketch *s, double q) {
+    if (s->count == 0) return 0;
+    if (q >= 1) return s->max;
+    uint64_t rank = (uint64_t)(q * (s->count - 1));
+    uint64_t seen = s->zero_count;
+    if (rank < seen) return s->min > 0 ? s->min : 0;
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        seen += s->counts[i];
+        if (rank < seen) {
+            double value = sketch_bucket_value(i);
+            if (value < s->min) value = s->min;
+            if (value > s->max) value = s->max;
+            return value;
+        }
+    }
+    return s->max;
+}
+
+void summary_init(ResultSummary *summary) {
+    sketch_init(&summary->wait);
+    sketch_init(&summary->turnaround);
+    sketch_init(&summary->energy);
+    summary->total_exec = 0;
+    summary->count = 0;
+}
+
+void summary_add(ResultSummary *summary, const ProcessData *p) {
+    sketch_add(&summary->wait, p->wait_time);
+    sketch_add(&summary->turnaround, p->exec_time + p->wait_time);
+    sketch_add(&summary->energy, p->energy);
+    summary->total_exec += p->exec_time;
+    summary->count++;
+}
+
+/* Streams a results file (CSV from save_to_file() or a binary trace)
+   into the summary in one pass without keeping the records. */
+int load_results(const char *filename, ResultSummary *summary) {
+    if (trace_is_binary(filename)) {
+        TraceFile tf;
+        if (!trace_open(&tf, filename, TRACE_RESULTS)) return 0;
+        const int32_t *pid = trace_column(&tf, RESULTS_PID);
+        const float *energy = trace_column(&tf, RESULTS_ENERGY);
+        const float *exec_time = trace_column(&tf, RESULTS_EXEC_TIME);
+        const float *wait_time = trace_column(&tf, RESULTS_WAIT_TIME);
+        for (uint64_t i = 0; i < tf.header->row_count; i++) {
+            ProcessData p = {pid[i], energy[i], exec_time[i], wait_time[i]};
+            summary_add(summary, &p);
+        }
+        trace_close(&tf);
+        return 1;
+    }
+
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        printf("Error opening file!\n");
+        return 0;
+    }
+    char line[256];
+    int line_no = 1;
+    if (!fgets(line, sizeof(line), fp)) line[0] = '\0';
+    while (fgets(line, sizeof(line), fp)) {
+        ProcessData p;
+        line_no++;
+        if (sscanf(line, "%d,%f,%f,%f", &p.pid, &p.energy, &p.exec_time, &p.wait_time) != 4) {
+            fprintf(stderr, "%s:%d: malformed result line, skipped\n", filename, line_no);
+            continue;
+        }
+        summary_add(summary, &p);
+    }
+    fclose(fp);
+    return 1;
+}
+
+/* Histogram of per-process energy over HISTOGRAM_ROWS equal ranges
+   between the smallest and largest value, built from the sketch
+   buckets so it needs no second pass over the data. */
+void display_bar_chart(const QuantileSketch *energy) {
+    uint64_t rows[HISTOGRAM_ROWS] = {0};
+    double width = (energy->max - energy->min) / HISTOGRAM_ROWS;
+
+    printf("\n=== Energy Consumption Histogram ===\n");
+    if (energy->count == 0) {
+        printf("(no results)\n");
+        return;
+    }
+    rows[0] = energy->zero_count;
+    for (int i = 0; i < SKETCH_BUCKETS; i++) {
+        if (energy->counts[i] == 0) continue;
+        double value = sketch_bucket_value(i);
+        int row = width > 0 ? (int)((value - energy->min) / width) : 0;
+        if (row < 0) row = 0;
+        if (row >= HISTOGRAM_ROWS) row = HISTOGRAM_ROWS - 1;
+        rows[row] += energy->counts[i];
+    }
+
+    uint64_t tallest = 1;
+    for (int r = 0; r < HISTOGRAM_ROWS; r++) {
+        if (rows[r] > tallest) tallest = rows[r];
+    }
+    int row_count = width > 0 ? HISTOGRAM_ROWS : 1;
+    for (int r = 0; r < row_count; r++) {
+        double lo = energy->min + r * width;
+        printf("%9.1f - %9.1f J |", lo, width > 0 ? lo + width : energy->max);
+        int bars = (int)((rows[r] * HISTOGRAM_WIDTH + tallest - 1) / tallest);
         for (int j = 0; j < bars; j++) printf("█");
-        printf(" %.1fJ\n", processes[i].energy);
+        printf(" %llu\n", (unsigned long long)rows[r]);
     }
 }
 
-void display_summary(ProcessData processes[], int num_processes) {
-    float total_energy = 0, total_exec = 0, total_wait = 0;
-    for (int i = 0; i < num_processes; i++) {
-        total_energy += processes[i].energy;
-        total_exec += processes[i].exec_time;
-        total_wait += processes[i].wait_time;
-    }
-    printf("\n=== Performance Summary ===\n");
-    printf("Total Energy: %.1f Joules\n", total_energy);
-    printf("Avg Execution Time: %.1f ms\n", total_exec / num_processes);
-    printf("Avg Waiting Time: %.1f ms\n", total_wait / num_processes);
+static void print_quantiles(const char *label, const QuantileSketch *s) {
+    printf("%-15s | %9.1f | %9.1f | %9.1f | %9.1f | %9.1f\n", label,
+           s->count ? s->sum / s->count : 0, sketch_quantile(s, 0.5),
+           sketch_quantile(s, 0.9), sketch_quantile(s, 0.99), s->max);
 }
 
+void display_summary(const ResultSummary *summary) {
+    printf("\n=== Performance Summary (%llu processes) ===\n",
+           (unsigned long long)summary->count);
+    if (summary->count == 0) return;
+    printf("Total Energy: %.1f Joules\n", summary->energy.sum);
+    printf("Avg Execution Time: %.1f ms\n", summary->total_exec / summary->count);
+    printf("Avg Waiting Time: %.1f ms\n", summary->wait.sum / summary->count);
+    printf("\nMetric          |      Mean |       p50 |       p90 |       p99 |       Max\n");
+    print_quantiles("Wait (ms)", &summary->wait);
+    print_quantiles("Turnaround (ms)", &summary->turnaround);
+    print_quantiles("Energy (J)", &summary->energy);
+}
 
-void save_to_file(ProcessData processes[], int num_processes) {
+void save_to_file(const ProcessData processes[], int num_processes) {
     FILE *fp = fopen("results.txt", "w");
     if (fp == NULL) {
         printf("Error opening file!\n");
@@ -52,16 +192,111 @@ void save_to_file(ProcessData processes[], int num_processes) {
     printf("Results saved to results.txt\n");
 }
 
-int main() {
-    ProcessData processes[MAX_PROCESSES];
-    int num_processes;
+/* Converts a results file between the CSV written by save_to_file() and
+   the binary TRACE_RESULTS format, in whichever direction the input is. */
+int convert_results(const char *input, const char *output) {
+    if (trace_is_binary(input)) {
+        TraceFile tf;
+        if (!trace_open(&tf, input, TRACE_RESULTS)) return 0;
+        const int32_t *pid = trace_column(&tf, RESULTS_PID);
+        const float *energy = trace_column(&tf, RESULTS_ENERGY);
+        const float *exec_time = trace_column(&tf, RESULTS_EXEC_TIME);
+        const float *wait_time = trace_column(&tf, RESULTS_WAIT_TIME);
+
+        FILE *fp = fopen(output, "w");
+        if (fp == NULL) {
+            printf("Error opening file!\n");
+            trace_close(&tf);
+            return 0;
+        }
+        fprintf(fp, "PID,Energy(J),ExecTime(ms),WaitTime(ms)\n");
+        for (uint64_t i = 0; i < tf.header->row_count; i++) {
+            fprintf(fp, "%d,%.1f,%.1f,%.1f\n", pid[i], energy[i], exec_time[i], wait_time[i]);
+        }
+        printf("Converted %llu results from %s to %s (CSV)\n",
+               (unsigned long long)tf.header->row_count, input, output);
+        trace_close(&tf);
+        return fclose(fp) == 0;
+    }
+
+    FILE *fp = fopen(input, "r");
+    if (fp == NULL) {
+        printf("Error opening file!\n");
+        return 0;
+    }
+
+    size_t rows = 0, capacity = 1024;
+    int32_t *pid = malloc(capacity * sizeof(int32_t));
+    float *energy = malloc(capacity * sizeof(float));
+    float *exec_time = malloc(capacity * sizeof(float));
+    float *wait_time = malloc(capacity * sizeof(float));
+    char line[256];
+    int line_no = 1;
+
+    if (!fgets(line, sizeof(line), fp)) line[0] = '\0';
+    while (pid && energy && exec_time && wait_time && fgets(line, sizeof(line), fp)) {
+        line_no++;
+        if (rows == capacity) {
+            capacity *= 2;
+            int32_t *grown_pid = realloc(pid, capacity * sizeof(int32_t));
+            if (grown_pid) pid = grown_pid;
+            float *grown_energy = realloc(energy, capacity * sizeof(float));
+            if (grown_energy) energy = grown_energy;
+            float *grown_exec = realloc(exec_time, capacity * sizeof(float));
+            if (grown_exec) exec_time = grown_exec;
+            float *grown_wait = realloc(wait_time, capacity * sizeof(float));
+            if (grown_wait) wait_time = grown_wait;
+            if (!grown_pid || !grown_energy || !grown_exec || !grown_wait) {
+                printf("Error allocating result columns\n");
+                fclose(fp);
+                free(pid);
+                free(energy);
+                free(exec_time);
+                free(wait_time);
+                return 0;
+            }
+        }
+        if (sscanf(line, "%d,%f,%f,%f", &pid[rows], &energy[rows],
+                   &exec_time[rows], &wait_time[rows]) != 4) {
+            fprintf(stderr, "%s:%d: malformed result line, skipped\n", input, line_no);
+            continue;
+        }
+        rows++;
+    }
+    fclose(fp);
+
+    int ok = pid && energy && exec_time && wait_time &&
+             trace_write_results(output, rows, pid, energy, exec_time, wait_time);
+    if (ok) {
+        printf("Converted %zu results from %s to %s (binary)\n", rows, input, output);
+    }
+    free(pid);
+    free(energy);
+    free(exec_time);
+    free(wait_time);
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    ResultSummary summary;
 
-load_results(processes, &num_processes);
+    if (argc == 4 && strcmp(argv[1], "convert") == 0) {
+        return convert_results(argv[2], argv[3]) ? 0 : 1;
+    }
 
-    display_bar_chart(processes, num_processes);
-    display_summary(processes, num_processes);
+    summary_init(&summary);
+    if (argc > 1) {
+        if (!load_results(argv[1], &summary)) return 1;
+    } else {
+        int num_processes = sizeof(sample_results) / sizeof(sample_results[0]);
+        for (int i = 0; i < num_processes; i++) {
+            summary_add(&summary, &sample_results[i]);
+        }
+        save_to_file(sample_results, num_processes);
+    }
 
-    save_to_file(processes, num_processes);
+    display_bar_chart(&summary.energy);
+    display_summary(&summary);
 
     return 0;
 }
@@ -1,18 +1,51 @@
 #ifndef VISUALIZATION_H
 #define VISUALIZATION_H
 
-#define MAX_PROCESSES 100
+#include <stdint.h>
+
+#define SKETCH_BUCKETS 2048
+#define SKETCH_ACCURACY 0.01   /* relative error of reported quantiles */
+#define SKETCH_MIN_VALUE 1e-6  /* smaller values are counted as zero */
+#define HISTOGRAM_ROWS 10
+#define HISTOGRAM_WIDTH 50
 
 typedef struct {
-    int pid;              
-    float energy;        
-    float exec_time;      
-    float wait_time;      
+    int pid;
+    float energy;
+    float exec_time;
+    float wait_time;
 } ProcessData;
 
-void load_results(ProcessData processes[], int *num_processes);
-void display_bar_chart(ProcessData processes[], int num_processes);
-void display_summary(ProcessData processes[], int num_processes);
-void save_to_file(ProcessData processes[], int num_processes);
+/* Log-bucketed quantile sketch: bucket i holds values in
+   (gamma^(i-1-offset), gamma^(i-offset)], so memory is fixed no matter
+   how many values are added and every quantile is within
+   SKETCH_ACCURACY of a true value. */
+typedef struct {
+    uint64_t counts[SKETCH_BUCKETS];
+    uint64_t zero_count;
+    uint64_t count;
+    double sum;
+    double min;
+    double max;
+} QuantileSketch;
+
+typedef struct {
+    QuantileSketch wait;
+    QuantileSketch turnaround;
+    QuantileSketch energy;
+    double total_exec;
+    uint64_t count;
+} ResultSummary;
+
+void sketch_init(QuantileSketch *s);
+void sketch_add(QuantileSketch *s, double value);
+double sketch_quantile(const QuantileSketch *s, double q);
+void summary_init(ResultSummary *summary);
+void summary_add(ResultSummary *summary, const ProcessData *p);
+int load_results(const char *filename, ResultSummary *summary);
+void display_bar_chart(const QuantileSketch *energy);
+void display_summary(const ResultSummary *summary);
+void save_to_file(const ProcessData processes[], int num_processes);
+int convert_results(const char *input, const char *output);
 
 #endif
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "workload.h"
+
+// splitmix64: a private generator keeps workloads identical for a given
+// seed regardless of the platform's rand() or of other callers using it.
+static unsigned long long next_random(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+WorkloadTask create_task(int id, float duration) {
+    WorkloadTask t;
+    t.id = id;
+    t.duration = duration;
+    t.energy_cost = 0.0;
+    t.arrival_time = 0;
+    t.priority = 0;
+    return t;
+}
+
+// Returns a caller-owned array; release it with free_workload().
+WorkloadTask* generate_workload(int num_tasks, int* seed) {
+    WorkloadTask* workload = (WorkloadTask*)malloc((num_tasks > 0 ? num_tasks : 1) * sizeof(WorkloadTask));
+    if (!workload) {
+        fprintf(stderr, "Error: Could not allocate workload of %d tasks\n", num_tasks);
+        return NULL;
+    }
+    unsigned long long state = (unsigned long long)(unsigned int)*seed;
+    int arrival = 0;
+    for (int i = 0; i < num_tasks; i++) {
+        float duration = (next_random(&state) % 45) + 5;
+        workload[i] = create_task(i + 1, duration);
+        workload[i].arrival_time = arrival;
+        workload[i].priority = next_random(&state) % 10;
+        arrival += next_random(&state) % 54;
+    }
+    *seed += 1; 
+    return workload;
+}
+
+void free_workload(WorkloadTask* workload) {
+    free(workload);
+}
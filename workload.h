@@ -0,0 +1,16 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+typedef struct {
+    int id;             
+    float duration;     // ms, uniform 5-49
+    float energy_cost;  
+    int arrival_time;   // ms, inter-arrival gaps average the mean duration
+    int priority;       // 0-9
+} WorkloadTask;
+
+WorkloadTask create_task(int id, float duration);
+WorkloadTask* generate_workload(int num_tasks, int* seed);
+void free_workload(WorkloadTask* workload);
+
+#endif